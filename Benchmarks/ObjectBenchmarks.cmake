@@ -4,6 +4,9 @@ get_filename_component(KubeObjectBenchmarksDir ${CMAKE_CURRENT_LIST_FILE} PATH)
 
 set(KubeObjectBenchmarksSources
     ${KubeObjectBenchmarksDir}/Main.cpp
+    ${KubeObjectBenchmarksDir}/benchmarks_EventDispatcher.cpp
+    ${KubeObjectBenchmarksDir}/benchmarks_ObjectSignal.cpp
+    ${KubeObjectBenchmarksDir}/benchmarks_ObjectTree.cpp
 )
 
 add_executable(${CMAKE_PROJECT_NAME} ${KubeObjectBenchmarksSources})
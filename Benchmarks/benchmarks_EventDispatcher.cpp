@@ -0,0 +1,63 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmarks of EventDispatcher
+ */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/Object/Object.hpp>
+#include <Kube/Object/EventDispatcher.hpp>
+
+using namespace kF;
+using namespace kF::ObjectUtils;
+
+namespace
+{
+    /** @brief Build a tree of 'count' objects in branches of 16 nodes, one node out of 'handlerRatio' is a mouse handler */
+    void BuildHandlerTree(Tree &tree, Object * const objects, const Tree::Index count, const Tree::Index handlerRatio)
+    {
+        Tree::Index parent = Tree::RootIndex;
+
+        for (Tree::Index i = 0u; i != count; ++i) {
+            const auto flags = !(i % handlerRatio) ? Tree::Flags::MouseHandler : Tree::Flags::None;
+            const auto index = tree.add(parent, &objects[i], static_cast<HashedName>(i + 1u), flags);
+            if (!((i + 1u) % 16u))
+                parent = index;
+        }
+    }
+}
+
+static void EventDispatcher_Broadcast(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    const auto objects = std::make_unique<Object[]>(count);
+    Tree tree;
+
+    tree.setFlagIndexed(Tree::Flags::MouseHandler, true);
+    BuildHandlerTree(tree, objects.get(), count, 8u);
+    EventDispatcher dispatcher(tree, Tree::Flags::MouseHandler);
+    for (auto _ : state) {
+        dispatcher.dispatch([](Object &object, const Tree::Index, const EventDispatcher::Phase) {
+            benchmark::DoNotOptimize(&object);
+        });
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+BENCHMARK(EventDispatcher_Broadcast)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void EventDispatcher_DispatchTo(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    const auto objects = std::make_unique<Object[]>(count);
+    Tree tree;
+
+    BuildHandlerTree(tree, objects.get(), count, 8u);
+    EventDispatcher dispatcher(tree, Tree::Flags::MouseHandler);
+    const auto target = tree.nodeCount() - 1u;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(dispatcher.dispatchTo(target, [](Object &, const Tree::Index, const EventDispatcher::Phase) { return false; }));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+BENCHMARK(EventDispatcher_DispatchTo)->Arg(1000)->Arg(10000);
@@ -0,0 +1,111 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmarks of Object signals
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/Object/Object.hpp>
+
+using namespace kF;
+
+namespace
+{
+    class SignalFoo : public Object
+    {
+        K_DERIVED(SignalFoo, Object,
+            K_PROPERTY(int, data, 0),
+            K_SIGNAL(valueChanged, float)
+        )
+    };
+}
+
+static void ObjectSignal_EmitBusyObject(benchmark::State &state)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    const auto noise = state.range(0);
+    SignalFoo foo;
+    float total = 0.0f;
+
+    // Connections on other signals of the same object must not slow down the emitted one
+    for (auto i = 0; i != noise; ++i)
+        foo.connect<&SignalFoo::dataChanged>([] {});
+    foo.connect<&SignalFoo::valueChanged>([&total](float value) { total += value; });
+    for (auto _ : state)
+        emit foo.valueChanged(1.0f);
+    benchmark::DoNotOptimize(total);
+}
+BENCHMARK(ObjectSignal_EmitBusyObject)->Arg(0)->Arg(32)->Arg(512);
+
+static void ObjectSignal_EmitQueued(benchmark::State &state)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    const auto batch = state.range(0);
+    ObjectUtils::SignalQueue queue;
+    SignalFoo foo;
+    float total = 0.0f;
+
+    foo.connectQueued<&SignalFoo::valueChanged>(queue, [&total](float value) { total += value; });
+    for (auto _ : state) {
+        for (auto i = 0; i != batch; ++i)
+            emit foo.valueChanged(1.0f);
+        queue.processQueued();
+    }
+    benchmark::DoNotOptimize(total);
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(ObjectSignal_EmitQueued)->Arg(1)->Arg(64)->Arg(1024);
+
+static void ObjectSignal_EmitTyped(benchmark::State &state)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    const bool typed = state.range(0);
+    SignalFoo foo;
+    float total = 0.0f;
+
+    if (typed)
+        foo.connectTyped<&SignalFoo::valueChanged>([&total](float value) { total += value; });
+    else
+        foo.connect<&SignalFoo::valueChanged>([&total](float value) { total += value; });
+    for (auto _ : state)
+        emit foo.valueChanged(1.0f);
+    benchmark::DoNotOptimize(total);
+}
+BENCHMARK(ObjectSignal_EmitTyped)->Arg(false)->Arg(true);
+
+static void ObjectSignal_BatchedSetters(benchmark::State &state)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    constexpr auto ObjectCount = 1000;
+    constexpr auto SetCount = 20;
+    const bool batched = state.range(0);
+    std::unique_ptr<SignalFoo[]> foos(new SignalFoo[ObjectCount]);
+    int invocations = 0;
+
+    for (auto i = 0; i != ObjectCount; ++i)
+        foos[i].connect<&SignalFoo::dataChanged>([&invocations] { ++invocations; });
+    for (auto _ : state) {
+        const auto update = [&foos] {
+            for (auto i = 0; i != ObjectCount; ++i) {
+                for (auto j = 0; j != SetCount; ++j)
+                    foos[i].data(foos[i].data() + 1);
+            }
+        };
+        if (batched) {
+            ObjectUtils::SignalBatch batch;
+            update();
+        } else
+            update();
+    }
+    benchmark::DoNotOptimize(invocations);
+    state.counters["SlotInvocations"] = benchmark::Counter(invocations, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(ObjectSignal_BatchedSetters)->Arg(false)->Arg(true);
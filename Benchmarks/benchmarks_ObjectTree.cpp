@@ -0,0 +1,169 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmarks of ObjectTree
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <Kube/Object/Object.hpp>
+
+using namespace kF;
+using namespace kF::ObjectUtils;
+
+namespace
+{
+    /** @brief Build a tree of 'count' nodes where each node has a unique id (starting from 1) */
+    void BuildFlatTree(Tree &tree, const Tree::Index count)
+    {
+        Tree::Index parent = Tree::RootIndex;
+
+        for (Tree::Index i = 1u; i <= count; ++i) {
+            const auto index = tree.add(parent, nullptr, static_cast<HashedName>(i), Tree::Flags::None);
+            // Create a new branch every 16 nodes
+            if (!(i % 16u))
+                parent = index;
+        }
+    }
+}
+
+static void ObjectTree_FindLinear(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    Tree tree;
+
+    BuildFlatTree(tree, count);
+    HashedName id = 1u;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.findLinear(id));
+        id = id % count + 1u;
+    }
+}
+BENCHMARK(ObjectTree_FindLinear)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void ObjectTree_FindIndexed(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    Tree tree;
+
+    tree.setIdIndexed(true);
+    BuildFlatTree(tree, count);
+    HashedName id = 1u;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.find(id));
+        id = id % count + 1u;
+    }
+}
+BENCHMARK(ObjectTree_FindIndexed)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void ObjectTree_CountVisible(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    Tree tree;
+
+    BuildFlatTree(tree, count);
+    for (auto _ : state) {
+        const auto &visibles = tree.visibleStates();
+        benchmark::DoNotOptimize(std::count(visibles.begin(), visibles.end(), true));
+    }
+}
+BENCHMARK(ObjectTree_CountVisible)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void ObjectTree_Build(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+
+    for (auto _ : state) {
+        Tree tree;
+        BuildFlatTree(tree, count);
+        benchmark::DoNotOptimize(tree.nodeCount());
+    }
+}
+BENCHMARK(ObjectTree_Build)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void ObjectTree_BuildReserved(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+
+    for (auto _ : state) {
+        Tree tree(count + 1u);
+        BuildFlatTree(tree, count);
+        benchmark::DoNotOptimize(tree.nodeCount());
+    }
+}
+BENCHMARK(ObjectTree_BuildReserved)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void ObjectTree_Deserialize(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    Tree source;
+
+    BuildFlatTree(source, count);
+    std::vector<std::uint32_t> data(source.serializedSize() / sizeof(std::uint32_t));
+    source.serialize(data.data());
+    for (auto _ : state) {
+        Tree tree;
+        benchmark::DoNotOptimize(tree.deserialize(data.data(), data.size() * sizeof(std::uint32_t)));
+    }
+}
+BENCHMARK(ObjectTree_Deserialize)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void ObjectTree_RemoveWideChildren(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    const bool stable = state.range(1);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Tree tree;
+        tree.setChildOrderStable(stable);
+        const auto container = tree.add(Tree::RootIndex, nullptr, 1u, Tree::Flags::None);
+        for (Tree::Index i = 0u; i != count; ++i)
+            static_cast<void>(tree.add(container, nullptr, 0u, Tree::Flags::None));
+        state.ResumeTiming();
+        // Remove every child from the front, the worst case of a stable order
+        for (Tree::Index i = 0u; i != count; ++i)
+            tree.remove(tree.children()[container][0]);
+        benchmark::DoNotOptimize(tree.nodeCount());
+    }
+}
+BENCHMARK(ObjectTree_RemoveWideChildren)->Args({ 1000, true })->Args({ 1000, false })->Args({ 10000, true })->Args({ 10000, false });
+
+static void ObjectTree_FindInScope(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    Tree tree;
+
+    tree.setScopeCached(state.range(1));
+    BuildFlatTree(tree, count);
+    // Search the first node from the deepest one, the worst case of a scoped lookup
+    const auto from = tree.nodeCount() - 1u;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(tree.findInScope(1u, from));
+}
+BENCHMARK(ObjectTree_FindInScope)->Args({ 1000, false })->Args({ 1000, true })->Args({ 10000, false })->Args({ 10000, true });
+
+static void ObjectTree_Traverse(benchmark::State &state)
+{
+    const auto count = static_cast<Tree::Index>(state.range(0));
+    Tree tree;
+    Core::Vector<Tree::Index, Tree::Index> stack;
+
+    BuildFlatTree(tree, count);
+    const auto &children = tree.children();
+    for (auto _ : state) {
+        Tree::Index visited = 0u;
+        stack.push(Tree::RootIndex);
+        while (!stack.empty()) {
+            const auto index = stack.back();
+            stack.pop();
+            ++visited;
+            for (const auto childIndex : children[index])
+                stack.push(childIndex);
+        }
+        benchmark::DoNotOptimize(visited);
+    }
+    state.counters["ChildrenBytesPerNode"] = static_cast<double>(sizeof(Tree::Children));
+}
+BENCHMARK(ObjectTree_Traverse)->Arg(1000)->Arg(10000)->Arg(100000);
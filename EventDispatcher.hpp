@@ -0,0 +1,152 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Event dispatcher over a tree of objects
+ */
+
+#pragma once
+
+#include <algorithm>
+
+#include "Tree.hpp"
+
+namespace kF::ObjectUtils
+{
+    class EventDispatcher;
+}
+
+/** @brief Dispatches events to the objects of a tree holding a handler flag (MouseHandler, KeyHandler, ...)
+ *
+ *  Handlers are kept in a flattened list in tree order, renames and visibility changes never affect it
+ *  If the tree is journaled, the list is patched in the subtrees changed by the entries recorded since its last use,
+ *  else (or if these entries have been drained) it is rebuilt when the tree topology, flags or enabled states changed
+ *  Disabled subtrees are excluded from the list and nodes without the flag are never visited
+ *  Handlers may modify the tree or dispatch again: each dispatch walks its own copy of the list as node handles,
+ *  changes apply to the next dispatch and handlers removed meanwhile are skipped, even if their slot is reused
+*/
+class kF::ObjectUtils::EventDispatcher
+{
+public:
+    /** @brief Index of a node in the tree */
+    using Index = Tree::Index;
+
+    /** @brief Node flags */
+    using Flags = Tree::Flags;
+
+    /** @brief Propagation phase of an event
+     *  Capture goes from outermost handlers to innermost ones, bubble goes the other way */
+    enum class Phase : std::uint8_t {
+        Capture,
+        Bubble
+    };
+
+    /** @brief Construct a dispatcher for the handlers of 'flag' in 'tree' */
+    EventDispatcher(Tree &tree, const Flags flag) noexcept : _tree(&tree), _flag(flag) {}
+
+    /** @brief Move constructor */
+    EventDispatcher(EventDispatcher &&other) noexcept = default;
+
+    /** @brief Destructor */
+    ~EventDispatcher(void) noexcept = default;
+
+    /** @brief Move assignment */
+    EventDispatcher &operator=(EventDispatcher &&other) noexcept = default;
+
+
+    /** @brief Get the dispatched tree */
+    [[nodiscard]] Tree &tree(void) const noexcept { return *_tree; }
+
+    /** @brief Get the handler flag */
+    [[nodiscard]] Flags flag(void) const noexcept { return _flag; }
+
+
+    /** @brief Get the enabled handlers in tree order (parents before children), updating the list if the tree changed
+     *  The list is invalidated by any later call that updates it */
+    [[nodiscard]] const Core::Vector<Index, Index> &handlers(void) noexcept;
+
+    /** @brief Force the handler list to be rebuilt on next use */
+    void invalidate(void) noexcept { _sequence = NullGeneration; _topologyGeneration = NullGeneration; }
+
+
+    /** @brief Broadcast an event to every enabled handler, calling 'functor(object, index, phase)'
+     *  Capture phase visits handlers in tree order, bubble phase in reverse (topmost first)
+     *  If 'functor' returns a boolean, true consumes the event and stops the propagation
+     *  Returns the index of the handler that consumed the event, else NullIndex */
+    template<typename Functor>
+    Index dispatch(Functor &&functor, const Phase phase = Phase::Bubble);
+
+    /** @brief Route an event to 'target' through its handler ancestors, calling 'functor(object, index, phase)'
+     *  The capture phase goes from the outermost handler down to 'target', then the bubble phase goes back up
+     *  Nothing is dispatched if 'target' is effectively disabled
+     *  If 'functor' returns a boolean, true consumes the event and stops the propagation
+     *  Returns the index of the handler that consumed the event, else NullIndex */
+    template<typename Functor>
+    Index dispatchTo(const Index target, Functor &&functor);
+
+private:
+    /** @brief Generation of a list that must be rebuilt */
+    static constexpr std::uint64_t NullGeneration = std::numeric_limits<std::uint64_t>::max();
+
+    /** @brief Marks of the nodes changed since the last update */
+    static constexpr std::uint8_t NodeMark = 0b1; // The node itself changed (it may have been removed)
+    static constexpr std::uint8_t SubtreeMark = 0b10; // The node belongs to a changed subtree
+    static constexpr std::uint8_t RootMark = 0b11; // The node is the root of a changed subtree
+
+    Tree *_tree { nullptr };
+    Flags _flag { Flags::None };
+    bool _dispatching { false };
+    std::uint64_t _sequence { NullGeneration }; // Journal sequence number the list is up to date with
+    std::uint64_t _topologyGeneration { NullGeneration };
+    std::uint64_t _enabledGeneration { NullGeneration };
+    std::uint64_t _flagsGeneration { NullGeneration };
+    Core::Vector<Index, Index> _handlers {};
+    Core::Vector<Index, Index> _stack {}; // Traversal stack
+    Core::Vector<Index, Index> _changed {}; // Nodes changed since the last update, then roots of changed subtrees
+    Core::Vector<Index, Index> _marked {}; // Nodes marked during a patch
+    Core::Vector<std::uint8_t, Index> _marks {}; // Per-node marks, zeroed between patches
+    Core::Vector<Index, Index> _patched {}; // Patched list, swapped with the handler list
+    Core::Vector<Index, Index> _lhsPath {}; // Ancestors of the left node of a tree order comparison
+    Core::Vector<Index, Index> _rhsPath {}; // Ancestors of the right node of a tree order comparison
+    Core::Vector<Tree::NodeHandle, Index> _route {}; // Handlers walked by the outermost dispatch
+
+    /** @brief Restore the dispatching state when a dispatch ends, even by an exception */
+    struct DispatchGuard
+    {
+        bool &dispatching;
+        const bool previous;
+
+        ~DispatchGuard(void) noexcept { dispatching = previous; }
+    };
+
+    /** @brief Rebuild the handler list */
+    void rebuild(void) noexcept;
+
+    /** @brief Patch the handler list from the journal entries following 'from'
+     *  Handlers of changed subtrees are removed then collected again and merged in tree order */
+    void patch(const std::uint32_t from) noexcept;
+
+    /** @brief Record the tree state the handler list is up to date with */
+    void synchronize(void) noexcept;
+
+    /** @brief Mark a changed node and its hierarchy, returns false if the journal entries require a rebuild */
+    [[nodiscard]] bool markChanged(const Tree::JournalEntry &entry) noexcept;
+
+    /** @brief Append the handlers of 'root' hierarchy to 'list' in tree order */
+    void collect(const Index root, Core::Vector<Index, Index> &list) noexcept;
+
+    /** @brief Check if a node is attached to the tree root through enabled ancestors */
+    [[nodiscard]] bool isAttached(const Index index) const noexcept;
+
+    /** @brief Check if 'lhs' comes before 'rhs' in tree order, both nodes must be attached to the tree root */
+    [[nodiscard]] bool precedes(const Index lhs, const Index rhs) noexcept;
+
+    /** @brief Get the route buffer of a dispatch, nested dispatches use 'nested' to keep outer routes intact */
+    [[nodiscard]] Core::Vector<Tree::NodeHandle, Index> &routeBuffer(Core::Vector<Tree::NodeHandle, Index> &nested) noexcept
+        { return _dispatching ? nested : _route; }
+
+    /** @brief Call a dispatch functor, returns true if the event is consumed
+     *  Nodes that have been removed, lost their object or the handler flag during the dispatch are skipped */
+    template<typename Functor>
+    [[nodiscard]] bool invoke(Functor &functor, const Tree::NodeHandle handle, const Phase phase);
+};
+
+#include "EventDispatcher.ipp"
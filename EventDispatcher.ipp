@@ -0,0 +1,271 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Event dispatcher over a tree of objects
+ */
+
+inline const kF::Core::Vector<kF::ObjectUtils::EventDispatcher::Index, kF::ObjectUtils::EventDispatcher::Index> &
+    kF::ObjectUtils::EventDispatcher::handlers(void) noexcept
+{
+    const auto &journal = _tree->journal();
+    const auto begin = _tree->journalSequence();
+    const auto end = begin + journal.size();
+
+    // Patch the list if the journal still holds every mutation since last update
+    if (_tree->isJournaled() && _sequence >= begin && _sequence <= end) [[likely]] {
+        if (_sequence == end) [[likely]]
+            return _handlers;
+        patch(static_cast<std::uint32_t>(_sequence - begin));
+    // Renames and visibility changes don't affect the handler list
+    } else if (_topologyGeneration != _tree->topologyGeneration() || _enabledGeneration != _tree->enabledGeneration()
+            || _flagsGeneration != _tree->flagsGeneration()) [[unlikely]]
+        rebuild();
+    synchronize();
+    return _handlers;
+}
+
+inline void kF::ObjectUtils::EventDispatcher::rebuild(void) noexcept
+{
+    _handlers.clear();
+    collect(Tree::RootIndex, _handlers);
+}
+
+inline void kF::ObjectUtils::EventDispatcher::patch(const std::uint32_t from) noexcept
+{
+    const auto &journal = _tree->journal();
+    const auto &parents = _tree->parents();
+
+    if (const auto count = _tree->nodeCount(); _marks.size() < count)
+        _marks.resize(count, std::uint8_t {});
+    _changed.clear();
+    _marked.clear();
+    bool patchable = true;
+    for (auto it = journal.begin() + from, last = journal.end(); patchable && it != last; ++it)
+        patchable = markChanged(*it);
+    if (patchable) [[likely]] {
+        // Remove the handlers of changed nodes, the others keep their relative order
+        _patched.clear();
+        for (const auto index : _handlers) {
+            if (!_marks[index])
+                _patched.push(index);
+        }
+        std::swap(_handlers, _patched);
+        // Keep the outermost changed subtrees only
+        Index rootCount = 0u;
+        for (const auto index : _changed) {
+            if (_marks[index] != SubtreeMark)
+                continue;
+            if (const auto parentIndex = parents[index]; parentIndex != Tree::NullIndex && _marks[parentIndex] >= SubtreeMark)
+                continue;
+            _marks[index] = RootMark;
+            if (!isAttached(index)) [[unlikely]]
+                continue;
+            _changed[rootCount++] = index;
+        }
+        _changed.resize(rootCount);
+        std::sort(_changed.begin(), _changed.end(), [this](const Index lhs, const Index rhs) { return precedes(lhs, rhs); });
+        // Merge the handlers of each changed subtree at its place in tree order
+        _patched.clear();
+        auto it = _handlers.begin();
+        for (const auto root : _changed) {
+            const auto next = std::upper_bound(it, _handlers.end(), root,
+                [this](const Index lhs, const Index rhs) { return precedes(lhs, rhs); });
+            for (; it != next; ++it)
+                _patched.push(*it);
+            collect(root, _patched);
+        }
+        for (const auto last = _handlers.end(); it != last; ++it)
+            _patched.push(*it);
+        std::swap(_handlers, _patched);
+    } else [[unlikely]]
+        rebuild();
+    for (const auto index : _marked)
+        _marks[index] = std::uint8_t {};
+}
+
+inline void kF::ObjectUtils::EventDispatcher::synchronize(void) noexcept
+{
+    _sequence = _tree->isJournaled() ? _tree->journalSequence() + _tree->journal().size() : NullGeneration;
+    _topologyGeneration = _tree->topologyGeneration();
+    _enabledGeneration = _tree->enabledGeneration();
+    _flagsGeneration = _tree->flagsGeneration();
+}
+
+inline bool kF::ObjectUtils::EventDispatcher::markChanged(const Tree::JournalEntry &entry) noexcept
+{
+    switch (entry.event) {
+    case Tree::JournalEvent::IdChanged:
+    case Tree::JournalEvent::VisibleChanged:
+        return true;
+    case Tree::JournalEvent::Compacted:
+    case Tree::JournalEvent::Reset:
+        return false;
+    default:
+        break;
+    }
+    const auto index = entry.index;
+    // Entries preceding a compaction may refer to released slots
+    if (index >= _marks.size()) [[unlikely]]
+        return false;
+    if (!_marks[index]) {
+        _marks[index] = NodeMark;
+        _marked.push(index);
+    }
+    _changed.push(index);
+    // Removed nodes don't have any hierarchy, their slot may have been reused since
+    if (_marks[index] >= SubtreeMark || !(_tree->nodeGeneration(index) & 1u))
+        return true;
+    const auto &children = _tree->children();
+    _stack.clear();
+    _stack.push(index);
+    while (!_stack.empty()) {
+        const auto current = _stack.back();
+        _stack.pop();
+        if (!_marks[current])
+            _marked.push(current);
+        _marks[current] = SubtreeMark;
+        for (const auto childIndex : children[current]) {
+            if (_marks[childIndex] < SubtreeMark)
+                _stack.push(childIndex);
+        }
+    }
+    return true;
+}
+
+inline void kF::ObjectUtils::EventDispatcher::collect(const Index root, Core::Vector<Index, Index> &list) noexcept
+{
+    const auto &objects = _tree->objects();
+    const auto &enabled = _tree->enabledStates();
+    const auto &flags = _tree->flags();
+    const auto &children = _tree->children();
+    const auto flagCounts = _tree->flagCounts(_flag);
+    auto &stack = _stack;
+
+    stack.clear();
+    stack.push(root);
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop();
+        // Prune disabled subtrees and subtrees without any handler
+        if (!enabled[index] || (flagCounts && !(*flagCounts)[index])) [[unlikely]]
+            continue;
+        if (objects[index] && Tree::HasFlag(flags[index], _flag))
+            list.push(index);
+        const auto &nodeChildren = children[index];
+        for (auto it = nodeChildren.end(); it != nodeChildren.begin();)
+            stack.push(*--it);
+    }
+}
+
+inline bool kF::ObjectUtils::EventDispatcher::isAttached(const Index index) const noexcept
+{
+    const auto &enabled = _tree->enabledStates();
+    const auto &parents = _tree->parents();
+
+    if (index == Tree::RootIndex)
+        return true;
+    for (auto current = parents[index]; current != Tree::RootIndex; current = parents[current]) {
+        if (current == Tree::NullIndex || !enabled[current]) [[unlikely]]
+            return false;
+    }
+    return enabled[Tree::RootIndex];
+}
+
+inline bool kF::ObjectUtils::EventDispatcher::precedes(const Index lhs, const Index rhs) noexcept
+{
+    const auto &parents = _tree->parents();
+
+    _lhsPath.clear();
+    _rhsPath.clear();
+    for (auto index = lhs; index != Tree::NullIndex; index = parents[index])
+        _lhsPath.push(index);
+    for (auto index = rhs; index != Tree::NullIndex; index = parents[index])
+        _rhsPath.push(index);
+    // Walk down from the tree root until both paths diverge
+    auto lhsDepth = _lhsPath.size();
+    auto rhsDepth = _rhsPath.size();
+    while (lhsDepth && rhsDepth && _lhsPath[lhsDepth - 1u] == _rhsPath[rhsDepth - 1u]) {
+        --lhsDepth;
+        --rhsDepth;
+    }
+    // An ancestor comes before its descendants, else siblings of the divergence are compared
+    if (!lhsDepth || !rhsDepth)
+        return !lhsDepth && rhsDepth;
+    return _tree->childPosition(_lhsPath[lhsDepth - 1u]) < _tree->childPosition(_rhsPath[rhsDepth - 1u]);
+}
+
+template<typename Functor>
+inline kF::ObjectUtils::EventDispatcher::Index kF::ObjectUtils::EventDispatcher::dispatch(Functor &&functor, const Phase phase)
+{
+    const auto &list = handlers();
+    Core::Vector<Tree::NodeHandle, Index> nested;
+    auto &route = routeBuffer(nested);
+    const DispatchGuard guard { dispatching: _dispatching, previous: _dispatching };
+
+    // Walk a copy of the list as handles so that handlers can modify the tree or dispatch again
+    route.clear();
+    route.reserve(list.size());
+    for (const auto index : list)
+        route.push(_tree->handle(index));
+    _dispatching = true;
+    if (phase == Phase::Capture) {
+        for (const auto handle : route) {
+            if (invoke(functor, handle, phase)) [[unlikely]]
+                return handle.index;
+        }
+    } else {
+        for (auto it = route.end(); it != route.begin();) {
+            const auto handle = *--it;
+            if (invoke(functor, handle, phase)) [[unlikely]]
+                return handle.index;
+        }
+    }
+    return Tree::NullIndex;
+}
+
+template<typename Functor>
+inline kF::ObjectUtils::EventDispatcher::Index kF::ObjectUtils::EventDispatcher::dispatchTo(const Index target, Functor &&functor)
+{
+    const auto &objects = _tree->objects();
+    const auto &flags = _tree->flags();
+    const auto &parents = _tree->parents();
+    Core::Vector<Tree::NodeHandle, Index> nested;
+    auto &route = routeBuffer(nested);
+    const DispatchGuard guard { dispatching: _dispatching, previous: _dispatching };
+
+    if (!_tree->effectivelyEnabled(target)) [[unlikely]]
+        return Tree::NullIndex;
+    // Collect the route from 'target' to its outermost handler ancestor
+    route.clear();
+    for (auto index = target; index != Tree::NullIndex; index = parents[index]) {
+        if (objects[index] && Tree::HasFlag(flags[index], _flag))
+            route.push(_tree->handle(index));
+    }
+    _dispatching = true;
+    for (auto it = route.end(); it != route.begin();) {
+        const auto handle = *--it;
+        if (invoke(functor, handle, Phase::Capture)) [[unlikely]]
+            return handle.index;
+    }
+    for (const auto handle : route) {
+        if (invoke(functor, handle, Phase::Bubble)) [[unlikely]]
+            return handle.index;
+    }
+    return Tree::NullIndex;
+}
+
+template<typename Functor>
+inline bool kF::ObjectUtils::EventDispatcher::invoke(Functor &functor, const Tree::NodeHandle handle, const Phase phase)
+{
+    // The node may have been removed and its slot reused by another object since the route was collected
+    const auto index = _tree->resolve(handle);
+    if (index == Tree::NullIndex || !_tree->objects()[index] || !Tree::HasFlag(_tree->flags()[index], _flag)) [[unlikely]]
+        return false;
+    auto &object = *_tree->objects()[index];
+
+    if constexpr (std::is_same_v<std::invoke_result_t<Functor &, Object &, Index, Phase>, bool>)
+        return functor(object, index, phase);
+    else {
+        functor(object, index, phase);
+        return false;
+    }
+}
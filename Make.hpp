@@ -132,7 +132,7 @@ SCOPE: \
         static kF::Meta::Signal Cache; \
         if (!Cache) [[unlikely]] \
             Cache = getMetaType().findSignal<&_MetaType::name>(); \
-        emitSignal(Cache __VA_OPT__(, FORWARD_NAME_EACH(__VA_ARGS__))); \
+        emitResolvedSignal<&_MetaType::name>(Cache __VA_OPT__(, FORWARD_NAME_EACH(__VA_ARGS__))); \
     } \
 
 /** @brief Declare a public signal */
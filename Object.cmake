@@ -7,6 +7,19 @@ set(KubeObjectSources
     ${KubeObjectDir}/Object.ipp
     ${KubeObjectDir}/Tree.hpp
     ${KubeObjectDir}/Tree.ipp
+    ${KubeObjectDir}/TreeSnapshot.hpp
+    ${KubeObjectDir}/TreeSnapshot.ipp
+    ${KubeObjectDir}/TreeParallel.hpp
+    ${KubeObjectDir}/TreeParallel.ipp
+    ${KubeObjectDir}/TreePath.hpp
+    ${KubeObjectDir}/TreePath.ipp
+    ${KubeObjectDir}/WeakObjectHandle.hpp
+    ${KubeObjectDir}/EventDispatcher.hpp
+    ${KubeObjectDir}/EventDispatcher.ipp
+    ${KubeObjectDir}/SignalQueue.hpp
+    ${KubeObjectDir}/SignalQueue.ipp
+    ${KubeObjectDir}/SignalBatch.hpp
+    ${KubeObjectDir}/SignalBatch.ipp
     ${KubeObjectDir}/Reflection.hpp
     ${KubeObjectDir}/Reflection.cpp
     ${KubeObjectDir}/Register.hpp
@@ -20,6 +33,10 @@ PUBLIC
     KubeMeta
 )
 
+if(${KF_OBJECT_COMPACT_TREE})
+    target_compile_definitions(${PROJECT_NAME} PUBLIC KUBE_OBJECT_COMPACT_TREE)
+endif()
+
 if(${KF_TESTS})
     include(${KubeObjectDir}/Tests/ObjectTests.cmake)
 endif()
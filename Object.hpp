@@ -7,8 +7,15 @@
 
 #include "Reflection.hpp"
 #include "Tree.hpp"
+#include "TreePath.hpp"
+#include "WeakObjectHandle.hpp"
+#include "SignalQueue.hpp"
+#include "SignalBatch.hpp"
 #include "ObjectRuntime.hpp"
 
+#include <memory>
+#include <unordered_map>
+
 namespace kF
 {
     class Object;
@@ -18,6 +25,10 @@ namespace kF
  *  It can be used to query meta properties or connect / emit meta signals */
 class kF::Object
 {
+    friend class ObjectUtils::Tree;
+    friend class ObjectUtils::SignalBatch;
+    friend class ObjectUtils::SignalQueue;
+
     K_ABSTRACT(Object,
         K_PROPERTY_CUSTOM_COPY(Object *, parent,
             static_cast<Object*(Object::*)(void) noexcept>(&Object::parent),
@@ -50,6 +61,123 @@ public:
     /** @brief Handle used to manipulate slots */
     using ConnectionHandle = Meta::SlotTable::OpaqueIndex;
 
+    /** @brief Record of a connection registered on an object
+     *  Connections owned by another object are linked into the receiver's list of owned connections
+     *  Connections sharing a single slot (see 'ConnectMultiple') are linked together in a ring */
+    struct Connection
+    {
+        /** @brief Kind of a connection, telling which list of its signal bucket refers to it */
+        enum class Kind : std::uint8_t {
+            Direct,
+            Queued,
+            Typed
+        };
+
+        Connection *prev { nullptr };
+        Connection *next { nullptr };
+        Connection *sibling { nullptr };
+        Object *sender { nullptr };
+        Object *receiver { nullptr };
+        Meta::SlotTable *slotTable { nullptr };
+        Meta::Signal signal {};
+        ConnectionHandle handle {};
+        std::uint32_t bucket { 0u };
+        std::uint32_t position { 0u };
+        Kind kind { Kind::Direct };
+    };
+
+    /** @brief Key of a connection record, handles are only unique within their slot table */
+    struct ConnectionKey
+    {
+        const Meta::SlotTable *slotTable { nullptr };
+        ConnectionHandle handle {};
+
+        [[nodiscard]] bool operator==(const ConnectionKey &other) const noexcept = default;
+    };
+
+    /** @brief Hash of a connection key */
+    struct ConnectionKeyHash
+    {
+        [[nodiscard]] std::size_t operator()(const ConnectionKey &key) const noexcept
+            { return std::hash<const void *>()(key.slotTable) ^ std::hash<ConnectionHandle>()(key.handle); }
+    };
+
+    /** @brief Connection records registered on an object */
+    using Connections = std::unordered_map<ConnectionKey, Connection, ConnectionKeyHash>;
+
+    /** @brief A connection invoked with boxed arguments
+     *  Entries whose connection is null have been disconnected, emissions skip them until the bucket is compacted */
+    struct DirectSlot
+    {
+        ConnectionHandle handle {};
+        Connection *connection { nullptr };
+    };
+
+    /** @brief A connection whose invocation is deferred to the owner of a signal queue
+     *  'queuePosition' is the index of the connection in the list tracked by its queue
+     *  'token' is pushed along with each emission so that the queue drops them once the connection is released */
+    struct QueuedSlot
+    {
+        ObjectUtils::SignalQueue *queue { nullptr };
+        ConnectionHandle handle {};
+        std::uint32_t queuePosition { 0u };
+        ObjectUtils::SignalQueue::ConnectionToken token {};
+        Connection *connection { nullptr };
+    };
+
+    /** @brief A connection whose slot is called directly with the static arguments of its signal
+     *  'thunk' is the type-erased 'TypedSignal<...>::Thunk' of the signal, 'handle' refers to its boxed adapter
+     *  The functor of a disconnected entry is released when its bucket is compacted, since it may still be running */
+    struct TypedSlot
+    {
+        void (*thunk)(void) { nullptr };
+        void (*destroy)(void * const) noexcept { nullptr };
+        void *functor { nullptr };
+        ConnectionHandle handle {};
+        Connection *connection { nullptr };
+    };
+
+    /** @brief Connections registered on a single signal of an object through a single slot table
+     *  Emitting a signal only walks the handles of the bucket matching its slot table and never modifies it
+     *  'deadCount' is the number of disconnected entries, they are removed by the next connection to the bucket
+     *  or once they make up half of it, unless an emission is in progress
+     *  'deferred' is set while an emission of the signal through the slot table is recorded by a 'SignalBatch' */
+    struct SignalSlots
+    {
+        Meta::Signal signal {};
+        Meta::SlotTable *slotTable { nullptr };
+        Core::TinyVector<DirectSlot> handles {};
+        Core::TinyVector<QueuedSlot> queuedHandles {};
+        Core::TinyVector<TypedSlot> typedHandles {};
+        std::uint32_t deadCount { 0u };
+        bool deferred { false };
+    };
+
+    /** @brief Static signature of a signal pointer, used to call typed slots */
+    template<typename SignalType>
+    struct TypedSignal;
+
+    template<typename Class, typename ...Params>
+    struct TypedSignal<void(Class::*)(Params...)>
+    {
+        /** @brief Type of the thunk calling a typed slot */
+        using Thunk = void(*)(void * const, Params...);
+
+        /** @brief Call a typed slot, dropping the arguments if it doesn't take them */
+        template<typename Functor>
+        static void Invoke(void * const functor, Params ...params);
+
+        /** @brief Release a typed slot */
+        template<typename Functor>
+        static void Destroy(void * const functor) noexcept
+            { delete reinterpret_cast<Functor *>(functor); }
+
+        /** @brief Make the slot table adapter of a typed slot, used when its signal is emitted with boxed arguments */
+        template<typename Functor>
+        [[nodiscard]] static auto MakeBoxedSlot(void * const functor) noexcept
+            { return [functor](Params ...params) { Invoke<Functor>(functor, std::forward<Params>(params)...); }; }
+    };
+
     /** @brief Connection table of an object */
     struct alignas_double_cacheline Cache
     {
@@ -58,8 +186,9 @@ public:
         ObjectIndex index { ObjectUtils::Tree::NullIndex };
         ObjectIndex parentIndex { ObjectUtils::Tree::NullIndex };
         Meta::SlotTable *slotTable { &Meta::Signal::GetSlotTable() };
-        Core::TinyVector<std::pair<Meta::Signal, ConnectionHandle>> registeredSlots {};
-        Core::TinyVector<ConnectionHandle> ownedSlots {};
+        Core::TinyVector<SignalSlots> registeredSlots {};
+        std::unique_ptr<Connections> connections {};
+        Connection *ownedConnections { nullptr };
         // Cacheline 2
         ObjectUtils::ObjectRuntime runtime;
     };
@@ -75,7 +204,7 @@ public:
     /** @brief Move constructor is disabled since it could break signal / slot behavior */
     Object(Object &&other) noexcept = delete;
 
-    /** @brief Virtual destructor (time vary upon connection count) */
+    /** @brief Virtual destructor (linear in connection count) */
     virtual ~Object(void) noexcept;
 
 
@@ -131,6 +260,15 @@ public:
      *  Note that only objects in a tree can have a visible state */
     void visible(const bool state) noexcept_ndebug;
 
+    /** @brief Get the object effective enabled state (false if the object or one of its parents is disabled)
+     *  Note that only objects in a tree can have a enabled state */
+    [[nodiscard]] bool effectivelyEnabled(void) const noexcept;
+
+    /** @brief Get the object effective visible state (false if the object or one of its parents is hidden)
+     *  Note that only objects in a tree can have a visible state */
+    [[nodiscard]] bool effectivelyVisible(void) const noexcept;
+
+
     /** @brief Check if the instance has an object cache */
     [[nodiscard]] bool hasObjectCache(void) const noexcept
         { return _cache.operator bool(); }
@@ -139,6 +277,19 @@ public:
     [[nodiscard]] bool isInTree(void) const noexcept
         { return _cache && _cache->tree; }
 
+    /** @brief Get the tree the instance lives in, if any */
+    [[nodiscard]] ObjectUtils::Tree *objectTree(void) const noexcept
+        { return _cache ? _cache->tree : nullptr; }
+
+    /** @brief Get the index of the instance in its tree (NullIndex if not in a tree) */
+    [[nodiscard]] ObjectIndex objectIndex(void) const noexcept
+        { return _cache ? _cache->index : ObjectUtils::Tree::NullIndex; }
+
+    /** @brief Get a weak handle over the instance (null handle if not in a tree)
+     *  The handle resolves in O(1) and returns null once the instance leaves its tree node */
+    [[nodiscard]] WeakObjectHandle weakHandle(void) const noexcept
+        { return isInTree() ? WeakObjectHandle(*_cache->tree, _cache->index) : WeakObjectHandle(); }
+
     /** @brief Check if the instance has a parent and thus is in a tree */
     [[nodiscard]] bool hasParent(void) const noexcept
         { return _cache && _cache->parentIndex != ObjectUtils::Tree::RootIndex && _cache->parentIndex != ObjectUtils::Tree::NullIndex; }
@@ -164,18 +315,42 @@ public:
     void parent(Object &parent) noexcept_ndebug;
 
     /** @brief Set the parent object and its ID and inserts this instance into parent's object-tree
-     *  Note that this function will NOT preserve the ID of the object if already in a tree */
+     *  Note that this function will NOT preserve the ID of the object if already in a tree
+     *  If the object is in another tree, its whole subtree is transferred along (descendants keep their parent) */
     void parent(Object &parent, const HashedName id) noexcept_ndebug;
 
     /** @brief Set the parent object and its ID and inserts this instance into an object-tree
-     *  Note that this function will NOT preserve the ID of the object if already in a tree */
+     *  Note that this function will NOT preserve the ID of the object if already in a tree
+     *  If the object is in another tree, its whole subtree is transferred along (descendants keep their parent) */
     void parent(ObjectUtils::Tree &tree, ObjectIndex parentIndex, const HashedName id) noexcept;
 
+    /** @brief Insert a whole array of objects into an object-tree in a single pass, below 'parentIndex'
+     *  Each node's 'parent' is either the position of its parent in the array or NullIndex to use 'parentIndex'
+     *  Each node's 'flags' is filled from its object's 'getObjectFlags' and objects must not be in a tree yet
+     *  Per-child callbacks and 'parentChanged' are still emitted, but each parent emits 'childrenCountChanged' only once */
+    static void ParentBatch(ObjectUtils::Tree &tree, const ObjectIndex parentIndex,
+            ObjectUtils::Tree::BatchNode * const begin, ObjectUtils::Tree::BatchNode * const end) noexcept_ndebug;
+
+    /** @brief Replace an object-tree by a serialized one and instantiate its objects in a single pass
+     *  'factory(typeName, index)' is called in index order for each node that held an object when serialized,
+     *  with the meta type name of that object, and returns the object to bind (or null)
+     *  Objects are owned by the caller, the factory typically resolves the meta type by name and constructs it
+     *  No callback nor signal is emitted, returns false (leaving the tree untouched) if the data is invalid */
+    template<typename Factory>
+    [[nodiscard]] static bool InstantiateTree(ObjectUtils::Tree &tree, const void * const data, const std::size_t size, Factory &&factory);
+
     /** @brief Remove links to the actual parent
      *  This function assert that object is in a tree
-     *  Note that this function loses the actual ID of the object */
+     *  Note that this function loses the actual ID of the object
+     *  Children stay in the tree without any parent and are notified of their parent change */
     void removeFromTree(void) noexcept_ndebug;
 
+    /** @brief Remove every descendant from the tree in a single pass
+     *  This function assert that object is in a tree
+     *  Direct children are notified of their parent change, deeper descendants silently leave the tree
+     *  Destroying detached descendants afterwards doesn't perform any tree work */
+    void removeChildrenFromTree(void) noexcept_ndebug;
+
     /** @brief Returns the number of children if any */
     [[nodiscard]] ObjectIndex childrenCount(void) const noexcept;
 
@@ -200,6 +375,14 @@ public:
      *  Be aware that id can collide and thus, the function will return the first match */
     [[nodiscard]] Object *findGlobal(const HashedName id) const noexcept;
 
+    /** @brief Finds a descendant object in the attached tree by following a path of hashed names from 'this'
+     *  Each name is searched in the close children of the previous match */
+    [[nodiscard]] Object *findPath(const std::initializer_list<HashedName> path) const noexcept;
+
+    /** @brief Finds a descendant object in the attached tree using a compiled path from 'this'
+     *  The path memoizes its result until the tree structure changes */
+    [[nodiscard]] Object *findPath(ObjectUtils::TreePath &path) const noexcept;
+
 
     /** @brief Unsafe object runtime getter */
     [[nodiscard]] ObjectUtils::ObjectRuntime &objectRuntime(void) noexcept { return _cache->runtime; }
@@ -345,7 +528,50 @@ public:
         { return connect<IsEnsureCache::Yes, const Receiver, Slot>(slotTable, signal, &receiver, std::forward<Slot>(slot)); }
 
 
-    /** @brief Fully disconnect every connection of an object */
+    /** @brief Register a queued slot into an owned signal using signal pointer or hashed name
+     *  Emitting the signal from any thread copies its arguments into 'queue', the slot is invoked by 'queue.processQueued'
+     *  Reference arguments are copied too, thus the slot can't write back into them
+     *  Connections must not be modified while another thread emits on the same object
+     *
+     *  If: no receiver is passed, the slot is owned by the calling instance
+     *  Else If: receiver is an Object-derived class, it will own the connection (and will release it when destroyed)
+     *      If: the given slot is a member function, receiver must be the instance used to perform the call */
+    template<auto SignalPtr, typename Slot>
+    ConnectionHandle connectQueued(ObjectUtils::SignalQueue &queue, Slot &&slot)
+        noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
+        { return connectQueued<void, Slot>(getDefaultSlotTable(), getMetaType().findSignal<SignalPtr>(), queue, nullptr, std::forward<Slot>(slot)); }
+    template<auto SignalPtr, typename Receiver, typename Slot>
+    ConnectionHandle connectQueued(ObjectUtils::SignalQueue &queue, Receiver &receiver, Slot &&slot)
+        noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
+        { return connectQueued<Receiver, Slot>(getDefaultSlotTable(), getMetaType().findSignal<SignalPtr>(), queue, &receiver, std::forward<Slot>(slot)); }
+    template<typename Slot>
+    ConnectionHandle connectQueued(ObjectUtils::SignalQueue &queue, const HashedName name, Slot &&slot)
+        noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
+        { return connectQueued<void, Slot>(getDefaultSlotTable(), findMetaSignal(name), queue, nullptr, std::forward<Slot>(slot)); }
+    template<typename Receiver, typename Slot>
+    ConnectionHandle connectQueued(ObjectUtils::SignalQueue &queue, const HashedName name, Receiver &receiver, Slot &&slot)
+        noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
+        { return connectQueued<Receiver, Slot>(getDefaultSlotTable(), findMetaSignal(name), queue, &receiver, std::forward<Slot>(slot)); }
+
+
+    /** @brief Register a statically typed slot into an owned signal using signal pointer
+     *  Emitting the signal through 'emitSignal<SignalPtr>' or its generated function calls the slot directly, without boxing arguments
+     *  Other emission paths using the default slot table still reach the slot through it
+     *
+     *  If: no receiver is passed, the slot is owned by the calling instance
+     *  Else If: receiver is an Object-derived class, it will own the connection (and will release it when destroyed)
+     *      If: the given slot is a member function, receiver must be the instance used to perform the call */
+    template<auto SignalPtr, typename Slot>
+    ConnectionHandle connectTyped(Slot &&slot)
+        noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
+        { return connectTyped<SignalPtr, void, Slot>(getDefaultSlotTable(), nullptr, std::forward<Slot>(slot)); }
+    template<auto SignalPtr, typename Receiver, typename Slot>
+    ConnectionHandle connectTyped(Receiver &receiver, Slot &&slot)
+        noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
+        { return connectTyped<SignalPtr, Receiver, Slot>(getDefaultSlotTable(), &receiver, std::forward<Slot>(slot)); }
+
+
+    /** @brief Fully disconnect every connection of an object, both registered and owned ones */
     void disconnect(void);
 
     /** @brief Disconnect every registered slot matching a specific signal either by pointer, hashed name or meta signal (may take custom SlotTable) */
@@ -407,10 +633,16 @@ public:
         { return disconnect<Receiver>(slotTable, signal, &receiver, handle); }
 
 
-    /** @brief Emit signal matching 'SignalPtr' using default slot table */
+    /** @brief Emit signal matching 'SignalPtr' using default slot table
+     *  Typed slots are called directly, before slots taking boxed arguments */
     template<auto SignalPtr, typename ...Args>
     void emitSignal(Args &&...args)
-        { emitSignal<IsEnsureCache::No, Args...>(getDefaultSlotTable(), getMetaType().findSignal<SignalPtr>(), std::forward<Args>(args)...); }
+        { emitTypedSignal<IsEnsureCache::No, SignalPtr, Args...>(getDefaultSlotTable(), getMetaType().findSignal<SignalPtr>(), std::forward<Args>(args)...); }
+
+    /** @brief Emit signal matching 'SignalPtr' using default slot table and its already resolved meta signal (used by generated signals) */
+    template<auto SignalPtr, typename ...Args>
+    void emitResolvedSignal(const Meta::Signal signal, Args &&...args)
+        { emitTypedSignal<IsEnsureCache::No, SignalPtr, Args...>(getDefaultSlotTable(), signal, std::forward<Args>(args)...); }
 
     /** @brief Emit signal matching 'name' using default slot table */
     template<typename ...Args>
@@ -425,7 +657,7 @@ public:
     /** @brief Emit signal matching 'SignalPtr' using a specific slot table*/
     template<auto SignalPtr, typename ...Args>
     void emitSignal(Meta::SlotTable &slotTable, Args &&...args)
-        { emitSignal<IsEnsureCache::Yes, Args...>(slotTable, getMetaType().findSignal<SignalPtr>(), std::forward<Args>(args)...); }
+        { emitTypedSignal<IsEnsureCache::Yes, SignalPtr, Args...>(slotTable, getMetaType().findSignal<SignalPtr>(), std::forward<Args>(args)...); }
 
     /** @brief Emit signal matching 'name' using a specific slot table */
     template<typename ...Args>
@@ -473,16 +705,65 @@ public:
 
 
 private:
+    /** @brief Number of emissions in progress on the current thread, buckets are not compacted while it isn't null */
+    static inline thread_local std::uint32_t _EmitDepth { 0u };
+
     std::unique_ptr<Cache> _cache {};
 
+    /** @brief Scope of an emission calling slots */
+    struct EmitGuard
+    {
+        EmitGuard(void) noexcept { ++_EmitDepth; }
+        ~EmitGuard(void) noexcept { --_EmitDepth; }
+    };
+
     /** @brief Ensure that object has a connection table */
     void ensureObjectCache(void) noexcept_ndebug;
 
+    /** @brief Find the registered slots bucket of a signal in a slot table (null if no slot was ever registered on it) */
+    [[nodiscard]] SignalSlots *findSignalSlots(const Meta::SlotTable &slotTable, const Meta::Signal signal) noexcept;
+
     /** @brief Connection implementation */
     template<IsEnsureCache EnsureCache, typename Receiver, typename Slot>
     ConnectionHandle connect(Meta::SlotTable &slotTable, const Meta::Signal signal, const void * const receiver, Slot &&slot)
         noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot));
 
+    /** @brief Queued connection implementation */
+    template<typename Receiver, typename Slot>
+    ConnectionHandle connectQueued(Meta::SlotTable &slotTable, const Meta::Signal signal,
+            ObjectUtils::SignalQueue &queue, const void * const receiver, Slot &&slot)
+        noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot));
+
+    /** @brief Typed connection implementation */
+    template<auto SignalPtr, typename Receiver, typename Slot>
+    ConnectionHandle connectTyped(Meta::SlotTable &slotTable, Receiver * const receiver, Slot &&slot)
+        noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot));
+
+    /** @brief Create the record of a connection registered on this instance and link it to its receiver, if any
+     *  The caller must insert the matching entry in the signal bucket */
+    [[nodiscard]] Connection &addConnection(Meta::SlotTable &slotTable, const Meta::Signal signal, const ConnectionHandle handle,
+            const Connection::Kind kind, Object * const receiver) noexcept_ndebug;
+
+    /** @brief Find the record of a connection registered on this instance (null if not found) */
+    [[nodiscard]] Connection *findConnection(const Meta::SlotTable &slotTable, const ConnectionHandle handle) noexcept;
+
+    /** @brief Remove the slot of a connection from its table and drop every record sharing it */
+    static void ReleaseConnection(Connection &connection) noexcept;
+
+    /** @brief Drop a connection record from its sender, its receiver and its queue, without touching its slot table */
+    static void DetachConnection(Connection &connection) noexcept;
+
+    /** @brief Remove the disconnected entries of a bucket list
+     *  Functors of disconnected typed entries are released */
+    template<typename Slots>
+    static void CompactSlots(Slots &slots) noexcept;
+
+    /** @brief Remove the disconnected entries of a bucket, unless an emission is in progress */
+    static void CompactSignalSlots(SignalSlots &signalSlots) noexcept;
+
+    /** @brief Compact a bucket once its disconnected entries make up half of it */
+    static void TrimSignalSlots(SignalSlots &signalSlots) noexcept;
+
     /** @brief Disconnect a member slot implementation */
     template<typename Receiver>
     bool disconnect(Meta::SlotTable &slotTable, const Meta::Signal signal, const void * const receiver, const ConnectionHandle handle);
@@ -491,6 +772,26 @@ private:
     template<IsEnsureCache EnsureCache, typename ...Args>
     void emitSignal(Meta::SlotTable &slotTable, const Meta::Signal signal, Args &&...args);
 
+    /** @brief Emit a signal whose pointer is known using a specific slot table */
+    template<IsEnsureCache EnsureCache, auto SignalPtr, typename ...Args>
+    void emitTypedSignal(Meta::SlotTable &slotTable, const Meta::Signal signal, Args &&...args);
+
+    /** @brief Record an argument-less emission into the batch of the current thread, if any
+     *  Returns true if the emission is deferred */
+    [[nodiscard]] bool deferSignal(Meta::SlotTable &slotTable, const Meta::Signal signal, SignalSlots &signalSlots) noexcept;
+
+    /** @brief Emit a signal recorded by a 'SignalBatch', unless it has already been emitted */
+    void emitDeferredSignal(Meta::SlotTable &slotTable, const Meta::Signal signal);
+
+    /** @brief Push queued slots of a bucket into their queue */
+    template<typename ...Args>
+    static void QueueSlots(Meta::SlotTable &slotTable, Core::TinyVector<QueuedSlot> &queuedHandles, const Args &...args);
+
+    /** @brief Invoke boxed slots of a bucket, detaching the ones removed from their table without disconnection
+     *  The bucket is accessed by index since slots may register new signals while they are called */
+    static void InvokeSlots(Meta::SlotTable &slotTable, Core::TinyVector<SignalSlots> &registeredSlots,
+            const std::uint32_t bucket, Var * const arguments);
+
     /** @brief ConnectionMultiple implementation */
     template<typename Receiver, typename Slot>
     static ConnectionHandle ConnectMultiple(Meta::SlotTable &slotTable,
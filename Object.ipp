@@ -7,7 +7,15 @@ inline kF::Object::~Object(void) noexcept
 {
     if (!_cache)
         return;
+    // Buckets may have been cleared while their emissions were still recorded
+    if (const auto batch = ObjectUtils::SignalBatch::Current(); batch) [[unlikely]]
+        batch->forget(*this);
     disconnect();
+    // Release the typed slots left behind by an emission in progress
+    for (const auto &signalSlots : _cache->registeredSlots) {
+        for (const auto &typed : signalSlots.typedHandles)
+            typed.destroy(typed.functor);
+    }
     if (_cache->tree)
         removeFromTree();
 }
@@ -43,8 +51,8 @@ inline void kF::Object::parent(Object &parentRef, const HashedName id) noexcept_
     kFAssert(parentRef._cache && parentRef._cache->tree,
         throw std::logic_error("Object::setParent: Parent object is not in a tree"));
     // Check if the object is already in a tree
-    if (_cache->parentIndex != ObjectUtils::Tree::NullIndex) [[unlikely]] {
-        const auto oldParent = parentUnsafe();
+    if (_cache->tree) [[unlikely]] {
+        const auto oldParent = parent();
         // Check if the new parent object is in the same tree
         if (_cache->tree == parentRef._cache->tree) [[likely]] {
             _cache->parentIndex = parentRef._cache->index;
@@ -57,13 +65,20 @@ inline void kF::Object::parent(Object &parentRef, const HashedName id) noexcept_
             emit parentRef.childrenCountChanged();
             onParentChanged(&parentRef);
             return;
-        // Else remove the object from its tree
+        // Else move the object and its descendants to the new tree
         } else [[unlikely]] {
-            _cache->tree->remove(_cache->index);
+            // The transfer rebinds the cache of every moved object
+            _cache->tree->transferSubtree(_cache->index, *parentRef._cache->tree, parentRef._cache->index);
+            _cache->tree->setId(_cache->index, id);
             if (oldParent) [[likely]] {
                 oldParent->onChildRemoved(*this);
                 emit oldParent->childrenCountChanged();
             }
+            parentRef.onChildAdded(*this);
+            emit parentRef.childrenCountChanged();
+            onParentChanged(&parentRef);
+            emit parentChanged();
+            return;
         }
     }
     _cache->tree = parentRef._cache->tree;
@@ -79,8 +94,8 @@ inline void kF::Object::parent(ObjectUtils::Tree &tree, ObjectUtils::Tree::Index
 {
     ensureObjectCache();
     // Check if the object is already in a tree
-    if (_cache->parentIndex != ObjectUtils::Tree::NullIndex) [[unlikely]] {
-        const auto oldParent = parentUnsafe();
+    if (_cache->tree) [[unlikely]] {
+        const auto oldParent = parent();
         // Check if the new parent object is in the same tree
         if (_cache->tree == &tree) [[likely]] {
             _cache->parentIndex = parentIndex;
@@ -92,18 +107,28 @@ inline void kF::Object::parent(ObjectUtils::Tree &tree, ObjectUtils::Tree::Index
             }
             if (parentPtr) [[likely]] {
                 parentPtr->onChildAdded(*this);
-                emit oldParent->childrenCountChanged();
+                emit parentPtr->childrenCountChanged();
             }
             onParentChanged(parentPtr);
             emit parentChanged();
             return;
-        // Else remove the object from its tree
+        // Else move the object and its descendants to the new tree
         } else [[unlikely]] {
-            _cache->tree->remove(_cache->index);
+            // The transfer rebinds the cache of every moved object
+            _cache->tree->transferSubtree(_cache->index, tree, parentIndex);
+            _cache->tree->setId(_cache->index, id);
+            const auto parentPtr = parentUnsafe();
             if (oldParent) [[likely]] {
                 oldParent->onChildRemoved(*this);
                 emit oldParent->childrenCountChanged();
             }
+            if (parentPtr) [[likely]] {
+                parentPtr->onChildAdded(*this);
+                emit parentPtr->childrenCountChanged();
+            }
+            onParentChanged(parentPtr);
+            emit parentChanged();
+            return;
         }
     }
     _cache->tree = &tree;
@@ -118,11 +143,81 @@ inline void kF::Object::parent(ObjectUtils::Tree &tree, ObjectUtils::Tree::Index
     emit parentChanged();
 }
 
+inline void kF::Object::ParentBatch(ObjectUtils::Tree &tree, const ObjectIndex parentIndex,
+        ObjectUtils::Tree::BatchNode * const begin, ObjectUtils::Tree::BatchNode * const end) noexcept_ndebug
+{
+    const auto count = static_cast<ObjectIndex>(std::distance(begin, end));
+    Core::Vector<bool, ObjectIndex> hasChildren;
+    bool parentHasChildren = false;
+
+    hasChildren.resize(count, false);
+    for (auto it = begin; it != end; ++it) {
+        kFAssert(it->object && !it->object->isInTree(),
+            throw std::logic_error("Object::ParentBatch: Batch objects must be valid and not in a tree"));
+        kFAssert(it->parent == ObjectUtils::Tree::NullIndex || it->parent < static_cast<ObjectIndex>(std::distance(begin, it)),
+            throw std::logic_error("Object::ParentBatch: A batch node must come after its parent"));
+        it->object->ensureObjectCache();
+        it->flags = it->object->getObjectFlags();
+        if (it->parent == ObjectUtils::Tree::NullIndex)
+            parentHasChildren = true;
+        else
+            hasChildren[it->parent] = true;
+    }
+    const auto indexes = tree.addBatch(parentIndex, begin, end);
+    for (ObjectIndex i = 0u; i != count; ++i) {
+        auto &cache = *begin[i].object->_cache;
+        cache.tree = &tree;
+        cache.index = indexes[i];
+        cache.parentIndex = begin[i].parent == ObjectUtils::Tree::NullIndex ? parentIndex : indexes[begin[i].parent];
+    }
+    // Per-child callbacks
+    for (auto it = begin; it != end; ++it) {
+        const auto parentPtr = it->object->parentUnsafe();
+        if (parentPtr) [[likely]]
+            parentPtr->onChildAdded(*it->object);
+        it->object->onParentChanged(parentPtr);
+        emit it->object->parentChanged();
+    }
+    // Coalesced children count signals
+    if (const auto parentPtr = tree.get(parentIndex).object; parentPtr && parentHasChildren)
+        emit parentPtr->childrenCountChanged();
+    for (ObjectIndex i = 0u; i != count; ++i) {
+        if (hasChildren[i])
+            emit begin[i].object->childrenCountChanged();
+    }
+}
+
+template<typename Factory>
+inline bool kF::Object::InstantiateTree(ObjectUtils::Tree &tree, const void * const data, const std::size_t size, Factory &&factory)
+{
+    if (!tree.deserialize(data, size)) [[unlikely]]
+        return false;
+    const auto typeNames = ObjectUtils::Tree::SerializedTypeNames(data);
+    for (ObjectIndex index = 0u, count = tree.nodeCount(); index != count; ++index) {
+        if (!typeNames[index])
+            continue;
+        const auto object = factory(typeNames[index], index);
+        if (!object) [[unlikely]]
+            continue;
+        kFAssert(!object->isInTree(),
+            throw std::logic_error("Object::InstantiateTree: Instantiated objects must not be in a tree"));
+        object->ensureObjectCache();
+        tree.bindObject(index, object);
+    }
+    return true;
+}
+
 inline void kF::Object::removeFromTree(void) noexcept_ndebug
 {
     kFAssert(isInTree(),
         throw std::logic_error("Object::removeFromTree: Object is not in a tree"));
-    const auto oldParent = parentUnsafe();
+    const auto oldParent = parent();
+    const auto &childIndexes = _cache->tree->get(_cache->index).children;
+    Core::Vector<Object *, ObjectIndex> children;
+
+    children.reserve(childIndexes.size());
+    for (const auto childIndex : childIndexes)
+        children.push(_cache->tree->get(childIndex).object);
     _cache->tree->remove(_cache->index);
     _cache->tree = nullptr;
     _cache->index = ObjectUtils::Tree::NullIndex;
@@ -133,6 +228,39 @@ inline void kF::Object::removeFromTree(void) noexcept_ndebug
     }
     onParentChanged(nullptr);
     emit parentChanged();
+    // Children stay in the tree without any parent
+    for (const auto child : children) {
+        if (!child) [[unlikely]]
+            continue;
+        onChildRemoved(*child);
+        child->onParentChanged(nullptr);
+        emit child->parentChanged();
+    }
+    if (!children.empty()) [[unlikely]]
+        emit childrenCountChanged();
+}
+
+inline void kF::Object::removeChildrenFromTree(void) noexcept_ndebug
+{
+    kFAssert(isInTree(),
+        throw std::logic_error("Object::removeChildrenFromTree: Object is not in a tree"));
+    const auto &childIndexes = _cache->tree->get(_cache->index).children;
+    Core::Vector<Object *, ObjectIndex> children;
+
+    if (childIndexes.empty()) [[unlikely]]
+        return;
+    children.reserve(childIndexes.size());
+    for (const auto childIndex : childIndexes)
+        children.push(_cache->tree->get(childIndex).object);
+    _cache->tree->removeChildren(_cache->index);
+    for (const auto child : children) {
+        if (!child) [[unlikely]]
+            continue;
+        onChildRemoved(*child);
+        child->onParentChanged(nullptr);
+        emit child->parentChanged();
+    }
+    emit childrenCountChanged();
 }
 
 inline kF::HashedName kF::Object::id(void) const noexcept
@@ -152,7 +280,7 @@ inline void kF::Object::id(const HashedName id) noexcept_ndebug
 {
     kFAssert(_cache->index != ObjectUtils::Tree::NullIndex,
         throw std::logic_error("Object::id: To set an object's id, the object must live inside an ObjectUtils::Tree"));
-    _cache->tree->get(_cache->index).id = id;
+    _cache->tree->setId(_cache->index, id);
 }
 
 inline bool kF::Object::enabled(void) const noexcept
@@ -172,7 +300,7 @@ inline void kF::Object::enabled(const bool state) noexcept_ndebug
 {
     kFAssert(_cache->index != ObjectUtils::Tree::NullIndex,
         throw std::logic_error("Object::enabled: To set an object's enabled state, the object must live inside an ObjectUtils::Tree"));
-    _cache->tree->get(_cache->index).enabled = state;
+    _cache->tree->setEnabled(_cache->index, state);
 }
 
 inline bool kF::Object::visible(void) const noexcept
@@ -192,7 +320,23 @@ inline void kF::Object::visible(const bool state) noexcept_ndebug
 {
     kFAssert(_cache->index != ObjectUtils::Tree::NullIndex,
         throw std::logic_error("Object::visible: To set an object's visible state, the object must live inside an ObjectUtils::Tree"));
-    _cache->tree->get(_cache->index).visible = state;
+    _cache->tree->setVisible(_cache->index, state);
+}
+
+inline bool kF::Object::effectivelyEnabled(void) const noexcept
+{
+    if (_cache && _cache->index != ObjectUtils::Tree::NullIndex) [[likely]]
+        return _cache->tree->effectivelyEnabled(_cache->index);
+    else [[unlikely]]
+        return false;
+}
+
+inline bool kF::Object::effectivelyVisible(void) const noexcept
+{
+    if (_cache && _cache->index != ObjectUtils::Tree::NullIndex) [[likely]]
+        return _cache->tree->effectivelyVisible(_cache->index);
+    else [[unlikely]]
+        return false;
 }
 
 inline kF::Object::ObjectIndex kF::Object::childrenCount(void) const noexcept
@@ -225,6 +369,28 @@ inline kF::Object *kF::Object::findGlobal(const HashedName id) const noexcept
         return nullptr;
 }
 
+inline kF::Object *kF::Object::findPath(const std::initializer_list<HashedName> path) const noexcept
+{
+    if (!_cache || !_cache->tree) [[unlikely]]
+        return nullptr;
+    const auto index = _cache->tree->findPath(_cache->index, path);
+    if (index != ObjectUtils::Tree::NullIndex) [[likely]]
+        return _cache->tree->get(index).object;
+    else [[unlikely]]
+        return nullptr;
+}
+
+inline kF::Object *kF::Object::findPath(ObjectUtils::TreePath &path) const noexcept
+{
+    if (!_cache || !_cache->tree) [[unlikely]]
+        return nullptr;
+    const auto index = path.resolve(*_cache->tree, _cache->index);
+    if (index != ObjectUtils::Tree::NullIndex) [[likely]]
+        return _cache->tree->get(index).object;
+    else [[unlikely]]
+        return nullptr;
+}
+
 [[nodiscard]] inline kF::Meta::Data kF::Object::findMetaData(const HashedName name) const noexcept
 {
     auto meta = getMetaType().findData(name);
@@ -313,6 +479,161 @@ inline void kF::Object::ensureObjectCache(void) noexcept_ndebug
         _cache = std::make_unique<Cache>();
 }
 
+inline kF::Object::SignalSlots *kF::Object::findSignalSlots(const Meta::SlotTable &slotTable, const Meta::Signal signal) noexcept
+{
+    for (auto &signalSlots : _cache->registeredSlots) {
+        if (signalSlots.signal == signal && signalSlots.slotTable == &slotTable)
+            return &signalSlots;
+    }
+    return nullptr;
+}
+
+inline kF::Object::Connection &kF::Object::addConnection(Meta::SlotTable &slotTable, const Meta::Signal signal, const ConnectionHandle handle,
+        const Connection::Kind kind, Object * const receiver) noexcept_ndebug
+{
+    auto &registeredSlots = _cache->registeredSlots;
+    std::uint32_t bucket = 0u;
+
+    // Find or insert the bucket of the signal in the slot table
+    while (bucket != registeredSlots.size()
+            && (registeredSlots[bucket].signal != signal || registeredSlots[bucket].slotTable != &slotTable))
+        ++bucket;
+    if (bucket == registeredSlots.size()) [[unlikely]]
+        registeredSlots.push(SignalSlots { signal: signal, slotTable: &slotTable });
+    else if (registeredSlots[bucket].deadCount) [[unlikely]]
+        CompactSignalSlots(registeredSlots[bucket]);
+    if (!_cache->connections) [[unlikely]]
+        _cache->connections = std::make_unique<Connections>();
+    const auto [it, inserted] = _cache->connections->try_emplace(ConnectionKey { slotTable: &slotTable, handle: handle });
+    kFAssert(inserted,
+        throw std::logic_error("Object::addConnection: Connection handle registered twice on the same object"));
+    auto &connection = it->second;
+    const auto &signalSlots = registeredSlots[bucket];
+    connection.sender = this;
+    connection.slotTable = &slotTable;
+    connection.signal = signal;
+    connection.handle = handle;
+    connection.bucket = bucket;
+    connection.kind = kind;
+    switch (kind) {
+    case Connection::Kind::Direct:
+        connection.position = signalSlots.handles.size();
+        break;
+    case Connection::Kind::Queued:
+        connection.position = signalSlots.queuedHandles.size();
+        break;
+    case Connection::Kind::Typed:
+        connection.position = signalSlots.typedHandles.size();
+        break;
+    }
+    // Link into the receiver's owned connections
+    if (receiver && receiver != this) {
+        receiver->ensureObjectCache();
+        connection.receiver = receiver;
+        connection.next = receiver->_cache->ownedConnections;
+        if (connection.next)
+            connection.next->prev = &connection;
+        receiver->_cache->ownedConnections = &connection;
+    }
+    return connection;
+}
+
+inline kF::Object::Connection *kF::Object::findConnection(const Meta::SlotTable &slotTable, const ConnectionHandle handle) noexcept
+{
+    if (!_cache || !_cache->connections) [[unlikely]]
+        return nullptr;
+    const auto it = _cache->connections->find(ConnectionKey { slotTable: &slotTable, handle: handle });
+    if (it != _cache->connections->end()) [[likely]]
+        return &it->second;
+    else [[unlikely]]
+        return nullptr;
+}
+
+inline void kF::Object::ReleaseConnection(Connection &connection) noexcept
+{
+    const auto slotTable = connection.slotTable;
+    const auto handle = connection.handle;
+    auto sibling = connection.sibling;
+
+    while (sibling && sibling != &connection) {
+        const auto next = sibling->sibling;
+        DetachConnection(*sibling);
+        sibling = next;
+    }
+    DetachConnection(connection);
+    slotTable->remove(handle);
+}
+
+inline void kF::Object::DetachConnection(Connection &connection) noexcept
+{
+    auto &sender = *connection.sender;
+    auto &signalSlots = sender._cache->registeredSlots[connection.bucket];
+
+    // Unlink from the receiver's owned connections
+    if (connection.receiver) {
+        if (connection.prev)
+            connection.prev->next = connection.next;
+        else
+            connection.receiver->_cache->ownedConnections = connection.next;
+        if (connection.next)
+            connection.next->prev = connection.prev;
+    }
+    // Clear the bucket entry, it is removed by the next compaction of the bucket
+    ++signalSlots.deadCount;
+    switch (connection.kind) {
+    case Connection::Kind::Direct:
+        signalSlots.handles[connection.position].connection = nullptr;
+        break;
+    case Connection::Kind::Queued:
+    {
+        auto &queued = signalSlots.queuedHandles[connection.position];
+        queued.queue->untrackConnection(queued.queuePosition);
+        queued.connection = nullptr;
+        break;
+    }
+    case Connection::Kind::Typed:
+        signalSlots.typedHandles[connection.position].connection = nullptr;
+        break;
+    }
+    sender._cache->connections->erase(ConnectionKey { slotTable: connection.slotTable, handle: connection.handle });
+}
+
+template<typename Slots>
+inline void kF::Object::CompactSlots(Slots &slots) noexcept
+{
+    std::uint32_t count = 0u;
+
+    for (std::uint32_t i = 0u, size = slots.size(); i != size; ++i) {
+        if (!slots[i].connection) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(slots[i])>, TypedSlot>)
+                slots[i].destroy(slots[i].functor);
+            continue;
+        }
+        slots[i].connection->position = count;
+        slots[count++] = slots[i];
+    }
+    slots.erase(slots.begin() + count, slots.end());
+}
+
+inline void kF::Object::CompactSignalSlots(SignalSlots &signalSlots) noexcept
+{
+    // An emission may be walking the bucket
+    if (_EmitDepth) [[unlikely]]
+        return;
+    CompactSlots(signalSlots.handles);
+    CompactSlots(signalSlots.queuedHandles);
+    CompactSlots(signalSlots.typedHandles);
+    signalSlots.deadCount = 0u;
+}
+
+inline void kF::Object::TrimSignalSlots(SignalSlots &signalSlots) noexcept
+{
+    const auto count = signalSlots.handles.size() + signalSlots.queuedHandles.size() + signalSlots.typedHandles.size();
+
+    if (signalSlots.deadCount * 2u >= count) [[unlikely]]
+        CompactSignalSlots(signalSlots);
+}
+
 template<kF::Object::IsEnsureCache EnsureCache, typename Receiver, typename Slot>
 inline kF::Object::ConnectionHandle kF::Object::connect(Meta::SlotTable &slotTable, const Meta::Signal signal, const void * const receiver, Slot &&slot)
     noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
@@ -328,16 +649,104 @@ inline kF::Object::ConnectionHandle kF::Object::connect(Meta::SlotTable &slotTab
         throw std::logic_error("Object::connect: Can't establish connection to invalid signal"));
 
     auto handle { slotTable.insert<Receiver>(receiver, std::forward<Slot>(slot)) };
+    Object *receiverObject = nullptr;
 
     if constexpr (EnsureCache == IsEnsureCache::Yes)
         ensureObjectCache();
-    _cache->registeredSlots.push(signal, handle);
-    if constexpr (std::is_base_of_v<Object, Receiver>) {
-        if (this != receiver) {
-            reinterpret_cast<Object*>(const_cast<void *>(receiver))->ensureObjectCache();
-            reinterpret_cast<Object*>(const_cast<void *>(receiver))->_cache->ownedSlots.push(handle);
-        }
+    if constexpr (std::is_base_of_v<Object, Receiver>)
+        receiverObject = reinterpret_cast<Object*>(const_cast<void *>(receiver));
+    auto &connection = addConnection(slotTable, signal, handle, Connection::Kind::Direct, receiverObject);
+    _cache->registeredSlots[connection.bucket].handles.push(DirectSlot { handle: handle, connection: &connection });
+    return handle;
+}
+
+template<typename Receiver, typename Slot>
+inline kF::Object::ConnectionHandle kF::Object::connectQueued(Meta::SlotTable &slotTable, const Meta::Signal signal,
+        ObjectUtils::SignalQueue &queue, const void * const receiver, Slot &&slot)
+    noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
+{
+    using Decomposer = Meta::Internal::FunctionDecomposerHelper<Slot>;
+
+    if constexpr (!std::is_same_v<Receiver, void> && Decomposer::IsMember && !Decomposer::IsFunctor) {
+        static_assert(std::is_same_v<Receiver, typename Decomposer::ClassType>, "You tried to connect receiver to a non-receiver member function");
+        static_assert(std::is_const_v<Receiver> == Decomposer::IsConst, "You tried to connect a volatile member slot with a constant receiver");
+    }
+
+    kFAssert(signal.operator bool(),
+        throw std::logic_error("Object::connectQueued: Can't establish connection to invalid signal"));
+
+    auto handle { slotTable.insert<Receiver>(receiver, std::forward<Slot>(slot)) };
+    Object *receiverObject = nullptr;
+
+    if constexpr (std::is_base_of_v<Object, Receiver>)
+        receiverObject = reinterpret_cast<Object*>(const_cast<void *>(receiver));
+    auto &connection = addConnection(slotTable, signal, handle, Connection::Kind::Queued, receiverObject);
+    const auto token = queue.acquireToken();
+    _cache->registeredSlots[connection.bucket].queuedHandles.push(QueuedSlot {
+        queue: &queue,
+        handle: handle,
+        queuePosition: queue.trackConnection(*this, slotTable, handle, token),
+        token: token,
+        connection: &connection
+    });
+    return handle;
+}
+
+template<typename Class, typename ...Params>
+template<typename Functor>
+inline void kF::Object::TypedSignal<void(Class::*)(Params...)>::Invoke(void * const functor, Params ...params)
+{
+    if constexpr (std::is_invocable_v<Functor &, Params...>)
+        std::invoke(*reinterpret_cast<Functor *>(functor), std::forward<Params>(params)...);
+    else
+        std::invoke(*reinterpret_cast<Functor *>(functor));
+}
+
+template<auto SignalPtr, typename Receiver, typename Slot>
+inline kF::Object::ConnectionHandle kF::Object::connectTyped(Meta::SlotTable &slotTable, Receiver * const receiver, Slot &&slot)
+    noexcept(nothrow_ndebug && nothrow_forward_constructible(Slot))
+{
+    using Signature = TypedSignal<decltype(SignalPtr)>;
+    using Decomposer = Meta::Internal::FunctionDecomposerHelper<Slot>;
+
+    const auto signal = getMetaType().findSignal<SignalPtr>();
+    kFAssert(signal.operator bool(),
+        throw std::logic_error("Object::connectTyped: Can't establish connection to invalid signal"));
+
+    void *functor;
+    typename Signature::Thunk thunk;
+    void (*destroy)(void * const) noexcept;
+    ConnectionHandle handle;
+    Object *receiverObject = nullptr;
+
+    if constexpr (!std::is_same_v<Receiver, void> && Decomposer::IsMember && !Decomposer::IsFunctor) {
+        static_assert(std::is_same_v<std::remove_const_t<Receiver>, typename Decomposer::ClassType>, "You tried to connect receiver to a non-receiver member function");
+        static_assert(std::is_const_v<Receiver> == Decomposer::IsConst, "You tried to connect a volatile member slot with a constant receiver");
+        auto member = [receiver, slot]<typename ...Args>(Args &&...args) requires std::is_invocable_v<Slot, Receiver &, Args...> {
+            std::invoke(slot, *receiver, std::forward<Args>(args)...);
+        };
+        using Functor = decltype(member);
+        functor = new Functor(std::move(member));
+        thunk = &Signature::template Invoke<Functor>;
+        destroy = &Signature::template Destroy<Functor>;
+        handle = slotTable.insert<void>(nullptr, Signature::template MakeBoxedSlot<Functor>(functor));
+    } else {
+        using Functor = std::remove_cvref_t<Slot>;
+        functor = new Functor(std::forward<Slot>(slot));
+        thunk = &Signature::template Invoke<Functor>;
+        destroy = &Signature::template Destroy<Functor>;
+        handle = slotTable.insert<void>(nullptr, Signature::template MakeBoxedSlot<Functor>(functor));
     }
+    if constexpr (std::is_base_of_v<Object, std::remove_const_t<Receiver>>)
+        receiverObject = const_cast<std::remove_const_t<Receiver> *>(receiver);
+    auto &connection = addConnection(slotTable, signal, handle, Connection::Kind::Typed, receiverObject);
+    _cache->registeredSlots[connection.bucket].typedHandles.push(TypedSlot {
+        thunk: reinterpret_cast<void(*)(void)>(thunk),
+        destroy: destroy,
+        functor: functor,
+        handle: handle,
+        connection: &connection
+    });
     return handle;
 }
 
@@ -359,94 +768,100 @@ inline kF::Object::ConnectionHandle kF::Object::ConnectMultiple(Meta::SlotTable
         throw std::logic_error("Object::ConnectMultiple: Number of objects must be equal to number of signals"));
 
     auto handle { slotTable.insert<Receiver>(receiver, std::forward<Slot>(slot)) };
+    Object *receiverObject = nullptr;
+    Connection *first = nullptr;
 
+    if constexpr (std::is_base_of_v<Object, Receiver>)
+        receiverObject = reinterpret_cast<Object*>(const_cast<void *>(receiver));
     while (objectBegin != objectEnd) {
         kFAssert(signalBegin->operator bool(),
             throw std::logic_error("Object::ConnectMultiple: Invalid signal in the list"));
         objectBegin->ensureObjectCache();
-        objectBegin->_cache->registeredSlots.push(*signalBegin, handle);
+        auto &connection = objectBegin->addConnection(slotTable, *signalBegin, handle, Connection::Kind::Direct, receiverObject);
+        objectBegin->_cache->registeredSlots[connection.bucket].handles.push(DirectSlot { handle: handle, connection: &connection });
+        // Link every record sharing the slot in a ring
+        if (!first) [[unlikely]] {
+            first = &connection;
+            connection.sibling = &connection;
+        } else [[likely]] {
+            connection.sibling = first->sibling;
+            first->sibling = &connection;
+        }
         ++objectBegin;
         ++signalBegin;
     }
-    if constexpr (std::is_base_of_v<Object, Receiver>) {
-        reinterpret_cast<Object*>(const_cast<void *>(receiver))->ensureObjectCache();
-        reinterpret_cast<Object*>(const_cast<void *>(receiver))->_cache->ownedSlots.push(handle);
-    }
     return handle;
 }
 
 inline void kF::Object::disconnect(void)
 {
-    auto &slotTable = getDefaultSlotTable<IsEnsureCache::No>();
-
-    for (auto owned : _cache->ownedSlots)
-        slotTable.remove(owned);
-    _cache->ownedSlots.clear();
-    for (const auto &registered : _cache->registeredSlots)
-        slotTable.remove(registered.second);
-    _cache->registeredSlots.clear();
+    while (_cache->ownedConnections) {
+        auto &connection = *_cache->ownedConnections;
+        auto &signalSlots = connection.sender->_cache->registeredSlots[connection.bucket];
+        ReleaseConnection(connection);
+        TrimSignalSlots(signalSlots);
+    }
+    if (_cache->connections) {
+        while (!_cache->connections->empty())
+            ReleaseConnection(_cache->connections->begin()->second);
+    }
+    // An emission may be walking the buckets, they only hold disconnected entries
+    if (!_EmitDepth) [[likely]] {
+        for (auto &signalSlots : _cache->registeredSlots)
+            CompactSlots(signalSlots.typedHandles);
+        _cache->registeredSlots.clear();
+    }
 }
 
 inline bool kF::Object::disconnect(Meta::SlotTable &slotTable, const Meta::Signal signal)
 {
-    auto it = std::remove_if(_cache->registeredSlots.begin(), _cache->registeredSlots.end(),
-        [&slotTable, signal](const auto &pair) {
-            if (pair.first != signal) [[likely]]
-                return false;
-            slotTable.remove(pair.second);
-            return true;
-        }
-    );
+    const auto signalSlots = findSignalSlots(slotTable, signal);
+    bool found = false;
 
-    if (it != _cache->registeredSlots.end()) [[likely]] {
-        _cache->registeredSlots.erase(it, _cache->registeredSlots.end());
-        return true;
-    }
-    return false;
+    if (!signalSlots) [[unlikely]]
+        return false;
+    const auto release = [&found](auto &slots) {
+        for (std::uint32_t i = 0u; i != slots.size(); ++i) {
+            if (slots[i].connection) {
+                ReleaseConnection(*slots[i].connection);
+                found = true;
+            }
+        }
+    };
+    release(signalSlots->handles);
+    release(signalSlots->queuedHandles);
+    release(signalSlots->typedHandles);
+    CompactSignalSlots(*signalSlots);
+    return found;
 }
 
 inline bool kF::Object::disconnect(Meta::SlotTable &slotTable, const Meta::Signal signal, const ConnectionHandle handle)
 {
-    auto it = _cache->registeredSlots.begin();
-    const auto end = _cache->registeredSlots.end();
+    const auto connection = findConnection(slotTable, handle);
 
-    while (it != end) {
-        if (it->first != signal || it->second != handle) [[likely]] {
-            ++it;
-            continue;
-        }
-        _cache->registeredSlots.erase(it);
-        slotTable.remove(handle);
-        return true;
-    }
-    return false;
+    if (!connection || connection->signal != signal) [[unlikely]]
+        return false;
+    auto &signalSlots = _cache->registeredSlots[connection->bucket];
+    ReleaseConnection(*connection);
+    TrimSignalSlots(signalSlots);
+    return true;
 }
 
 template<typename Receiver>
 inline bool kF::Object::disconnect(Meta::SlotTable &slotTable, const Meta::Signal signal, const void * const receiver, const ConnectionHandle handle)
 {
-    auto it = _cache->registeredSlots.begin();
-    const auto end = _cache->registeredSlots.end();
-    bool found = disconnect<std::is_base_of_v<Object, Receiver>>(slotTable, signal, handle);
+    const auto connection = findConnection(slotTable, handle);
 
+    if (!connection || connection->signal != signal) [[unlikely]]
+        return false;
     if constexpr (std::is_base_of_v<Object, Receiver>) {
-        auto it = reinterpret_cast<std::remove_cvref_t<Receiver *>>(receiver)->_cache.ownedSlots.begin();
-        const auto end = reinterpret_cast<std::remove_cvref_t<Receiver *>>(receiver)->_cache.ownedSlots.end();
-
-        while (it != end) {
-            if (*it != handle) [[likely]] {
-                ++it;
-                continue;
-            }
-            _cache->ownedSlots.erase(it);
-            if (!found) {
-                slotTable.remove(handle);
-                found = true;
-            }
-            break;
-        }
+        if (connection->receiver && connection->receiver != reinterpret_cast<const Object *>(receiver)) [[unlikely]]
+            return false;
     }
-    return found;
+    auto &signalSlots = _cache->registeredSlots[connection->bucket];
+    ReleaseConnection(*connection);
+    TrimSignalSlots(signalSlots);
+    return true;
 }
 
 template<kF::Object::IsEnsureCache EnsureCache, typename ...Args>
@@ -458,16 +873,169 @@ inline void kF::Object::emitSignal(Meta::SlotTable &slotTable, const Meta::Signa
         throw std::logic_error("Object::emitSignal: Invalid number of argument"));
     if constexpr (EnsureCache == IsEnsureCache::Yes)
         ensureObjectCache();
+    const auto signalSlots = findSignalSlots(slotTable, signal);
+    if (!signalSlots) [[likely]]
+        return;
+    if constexpr (sizeof...(Args) == 0) {
+        if (deferSignal(slotTable, signal, *signalSlots)) [[unlikely]]
+            return;
+    }
+    if (!signalSlots->queuedHandles.empty()) [[unlikely]]
+        QueueSlots(slotTable, signalSlots->queuedHandles, args...);
+    if (signalSlots->handles.empty() && signalSlots->typedHandles.empty()) [[unlikely]]
+        return;
     Var arguments[sizeof...(Args)] { Var::Assign(std::forward<Args>(args))... };
-    const auto it = std::remove_if(_cache->registeredSlots.begin(), _cache->registeredSlots.end(),
-        [&slotTable, signal, &arguments](auto &pair) -> bool {
-            if (signal != pair.first) [[likely]] {
-                return false;
-            } else [[unlikely]] {
-                return !slotTable.invoke(pair.second, arguments);
-            }
-        }
-    );
-    if (it != _cache->registeredSlots.end()) [[unlikely]]
-        _cache->registeredSlots.erase(it, _cache->registeredSlots.end());
-}
\ No newline at end of file
+    auto &registeredSlots = _cache->registeredSlots;
+    const auto bucket = static_cast<std::uint32_t>(signalSlots - registeredSlots.begin());
+    const EmitGuard guard;
+    for (std::uint32_t i = 0u; i != registeredSlots[bucket].typedHandles.size(); ++i) {
+        const auto typed = registeredSlots[bucket].typedHandles[i];
+        if (typed.connection) [[likely]]
+            slotTable.invoke(typed.handle, arguments);
+    }
+    InvokeSlots(slotTable, registeredSlots, bucket, arguments);
+}
+
+template<kF::Object::IsEnsureCache EnsureCache, auto SignalPtr, typename ...Args>
+inline void kF::Object::emitTypedSignal(Meta::SlotTable &slotTable, const Meta::Signal signal, Args &&...args)
+{
+    using Thunk = typename TypedSignal<decltype(SignalPtr)>::Thunk;
+
+    static_assert(std::is_invocable_v<Thunk, void * const, Args &...>,
+        "Object::emitSignal: Arguments don't match signal parameters");
+    kFAssert(signal,
+        throw std::logic_error("Object::emitSignal: Unknown signal"));
+    if constexpr (EnsureCache == IsEnsureCache::Yes)
+        ensureObjectCache();
+    const auto signalSlots = findSignalSlots(slotTable, signal);
+    if (!signalSlots) [[likely]]
+        return;
+    if constexpr (sizeof...(Args) == 0) {
+        if (deferSignal(slotTable, signal, *signalSlots)) [[unlikely]]
+            return;
+    }
+    if (!signalSlots->queuedHandles.empty()) [[unlikely]]
+        QueueSlots(slotTable, signalSlots->queuedHandles, args...);
+    auto &registeredSlots = _cache->registeredSlots;
+    const auto bucket = static_cast<std::uint32_t>(signalSlots - registeredSlots.begin());
+    const EmitGuard guard;
+    for (std::uint32_t i = 0u; i != registeredSlots[bucket].typedHandles.size(); ++i) {
+        const auto typed = registeredSlots[bucket].typedHandles[i];
+        if (typed.connection) [[likely]]
+            reinterpret_cast<Thunk>(typed.thunk)(typed.functor, args...);
+    }
+    if (registeredSlots[bucket].handles.empty()) [[likely]]
+        return;
+    Var arguments[sizeof...(Args)] { Var::Assign(std::forward<Args>(args))... };
+    InvokeSlots(slotTable, registeredSlots, bucket, arguments);
+}
+
+inline bool kF::Object::deferSignal(Meta::SlotTable &slotTable, const Meta::Signal signal, SignalSlots &signalSlots) noexcept
+{
+    const auto batch = ObjectUtils::SignalBatch::Current();
+
+    if (!batch || !batch->isRecording()) [[likely]]
+        return false;
+    if (!signalSlots.deferred) {
+        signalSlots.deferred = true;
+        batch->defer(*this, slotTable, signal);
+    }
+    return true;
+}
+
+inline void kF::Object::emitDeferredSignal(Meta::SlotTable &slotTable, const Meta::Signal signal)
+{
+    const auto signalSlots = findSignalSlots(slotTable, signal);
+
+    // The bucket may have been cleared or already emitted by a duplicated entry
+    if (!signalSlots || !signalSlots->deferred) [[unlikely]]
+        return;
+    signalSlots->deferred = false;
+    emitSignal<IsEnsureCache::No>(slotTable, signal);
+}
+
+template<typename ...Args>
+inline void kF::Object::QueueSlots(Meta::SlotTable &slotTable, Core::TinyVector<QueuedSlot> &queuedHandles, const Args &...args)
+{
+    for (const auto &queued : queuedHandles) {
+        if (queued.connection) [[likely]]
+            queued.queue->push(slotTable, queued.handle, queued.token, args...);
+    }
+}
+
+inline void kF::Object::InvokeSlots(Meta::SlotTable &slotTable, Core::TinyVector<SignalSlots> &registeredSlots,
+        const std::uint32_t bucket, Var * const arguments)
+{
+    for (std::uint32_t i = 0u; i != registeredSlots[bucket].handles.size(); ++i) {
+        const auto slot = registeredSlots[bucket].handles[i];
+        // The slot has been removed from its table without disconnection
+        if (slot.connection && !slotTable.invoke(slot.handle, arguments)) [[unlikely]]
+            DetachConnection(*slot.connection);
+    }
+}
+
+inline kF::ObjectUtils::SignalBatch::~SignalBatch(void) noexcept
+{
+    if (_Current != this) [[unlikely]]
+        return;
+    flush();
+    _Current = nullptr;
+}
+
+inline void kF::ObjectUtils::SignalBatch::flush(void)
+{
+    if (_Current != this) [[unlikely]]
+        return;
+    FlushGuard guard { batch: *this };
+
+    // Emissions of slots are not recorded while flushing, so entries can't grow
+    _flushing = true;
+    while (guard.flushed != _entries.size()) {
+        const auto entry = _entries[guard.flushed++];
+        if (entry.object)
+            entry.object->emitDeferredSignal(*entry.slotTable, entry.signal);
+    }
+}
+
+inline kF::ObjectUtils::SignalQueue::~SignalQueue(void) noexcept
+{
+    // Disconnect queued connections so their senders stop pushing into the queue
+    while (!_connections.empty()) {
+        const auto &tracked = _connections.back();
+        Object::ReleaseConnection(*tracked.sender->findConnection(*tracked.slotTable, tracked.handle));
+    }
+    // Pending emissions are released along with the node pool
+    for (auto &block : _blocks)
+        delete[] block.load(std::memory_order_relaxed);
+}
+
+inline void kF::ObjectUtils::SignalQueue::untrackConnection(const std::uint32_t position) noexcept
+{
+    const auto last = _connections.size() - 1u;
+    const auto token = _connections[position].token;
+
+    // Pending emissions of the connection become stale
+    ++_tokenGenerations[token.index];
+    _freeTokens.push(token.index);
+    // The last tracked connection takes the released position
+    if (position != last) {
+        const auto moved = _connections[last];
+        const auto connection = moved.sender->findConnection(*moved.slotTable, moved.handle);
+        auto &signalSlots = moved.sender->_cache->registeredSlots[connection->bucket];
+        signalSlots.queuedHandles[connection->position].queuePosition = position;
+        _connections[position] = moved;
+    }
+    _connections.pop();
+}
+
+inline void kF::ObjectUtils::Tree::UpdateObjectCache(Object * const object, Tree * const tree, const Index index, const Index parentIndex) noexcept
+{
+    object->_cache->tree = tree;
+    object->_cache->index = index;
+    object->_cache->parentIndex = parentIndex;
+}
+
+inline kF::HashedName kF::ObjectUtils::Tree::GetObjectTypeName(const Object * const object) noexcept
+{
+    return object->getMetaType().name();
+}
@@ -0,0 +1,96 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Scope coalescing argument-less signal emissions
+ */
+
+#pragma once
+
+#include <Kube/Meta/Meta.hpp>
+#include <Kube/Core/Vector.hpp>
+
+namespace kF
+{
+    class Object;
+
+    namespace ObjectUtils
+    {
+        class SignalBatch;
+    }
+}
+
+/** @brief Scope deferring argument-less signal emissions of the current thread until its destruction
+ *
+ *  While a batch is alive, emitting a signal without arguments (such as the 'nameChanged' signals of properties)
+ *  only records its (object, slot table, signal) triplet, an already recorded triplet is not recorded again
+ *  Each recorded signal is emitted once when the batch is flushed or destroyed, in the order of their first emission
+ *  Signals taking arguments and signals without any connection are still emitted immediately
+ *  Nested batches are merged into the outermost one
+ *  The destructor can't propagate exceptions: if batched slots may throw, call 'flush' before the end of the scope
+*/
+class kF::ObjectUtils::SignalBatch
+{
+public:
+    /** @brief A recorded emission */
+    struct Entry
+    {
+        Object *object { nullptr };
+        Meta::SlotTable *slotTable { nullptr };
+        Meta::Signal signal {};
+    };
+
+
+    /** @brief Get the batch recording emissions of the current thread (null if none) */
+    [[nodiscard]] static SignalBatch *Current(void) noexcept { return _Current; }
+
+
+    /** @brief Start recording emissions of the current thread, unless a batch is already recording them */
+    SignalBatch(void) noexcept;
+
+    /** @brief A batch can't be copied nor moved since it is referenced by the current thread */
+    SignalBatch(const SignalBatch &other) = delete;
+    SignalBatch(SignalBatch &&other) = delete;
+
+    /** @brief Emit the remaining recorded signals
+     *  A slot throwing from the destructor calls std::terminate, use 'flush' to handle exceptions of batched slots */
+    ~SignalBatch(void) noexcept;
+
+
+    /** @brief Check if the batch records emissions, false while recorded signals are being emitted */
+    [[nodiscard]] bool isRecording(void) const noexcept { return !_flushing; }
+
+    /** @brief Get the number of recorded emissions */
+    [[nodiscard]] std::uint32_t count(void) const noexcept { return _entries.size(); }
+
+
+    /** @brief Record the emission of a signal, the caller ensures it wasn't already recorded */
+    void defer(Object &object, Meta::SlotTable &slotTable, const Meta::Signal signal) noexcept;
+
+    /** @brief Drop every recorded emission of an object (used when the object is destroyed) */
+    void forget(const Object &object) noexcept;
+
+    /** @brief Emit every recorded signal then clear the batch, the batch keeps recording afterwards
+     *  Nested batches don't hold any emission, flushing them does nothing
+     *  If a slot throws, the exception is propagated and the emissions following it stay recorded */
+    void flush(void);
+
+private:
+    static inline thread_local SignalBatch *_Current { nullptr };
+
+    Core::Vector<Entry, std::uint32_t> _entries {};
+    bool _flushing { false };
+
+    /** @brief Drop flushed entries and restore recording when a flush ends, even by an exception */
+    struct FlushGuard
+    {
+        SignalBatch &batch;
+        std::uint32_t flushed { 0u };
+
+        ~FlushGuard(void) noexcept
+        {
+            batch._entries.erase(batch._entries.begin(), batch._entries.begin() + flushed);
+            batch._flushing = false;
+        }
+    };
+};
+
+#include "SignalBatch.ipp"
@@ -0,0 +1,27 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Scope coalescing argument-less signal emissions
+ */
+
+inline kF::ObjectUtils::SignalBatch::SignalBatch(void) noexcept
+{
+    if (!_Current) [[likely]]
+        _Current = this;
+}
+
+inline void kF::ObjectUtils::SignalBatch::defer(Object &object, Meta::SlotTable &slotTable, const Meta::Signal signal) noexcept
+{
+    _entries.push(Entry {
+        object: &object,
+        slotTable: &slotTable,
+        signal: signal
+    });
+}
+
+inline void kF::ObjectUtils::SignalBatch::forget(const Object &object) noexcept
+{
+    for (auto &entry : _entries) {
+        if (entry.object == &object)
+            entry.object = nullptr;
+    }
+}
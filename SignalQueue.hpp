@@ -0,0 +1,162 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Queue of signal emissions delivered on a consumer thread
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <limits>
+
+#include <Kube/Meta/Meta.hpp>
+#include <Kube/Core/SmallVector.hpp>
+#include <Kube/Core/Vector.hpp>
+
+namespace kF
+{
+    class Object;
+
+    namespace ObjectUtils
+    {
+        class SignalQueue;
+    }
+}
+
+/** @brief Lock-free multiple producers / single consumer queue of signal emissions
+ *
+ *  Queued connections push their slot handle along with a copy of the emitted arguments from any thread
+ *  The owner of the queue (usually the receiver's event loop) invokes them later with 'processQueued'
+ *  Slots are invoked on the consumer thread, using the slot table they were registered in
+ *  Each emission carries the liveness token of its connection, so emissions of a released connection are dropped
+ *  even if its slot handle has been reused meanwhile
+ *  Connections must be made and released on the consumer thread (or while it doesn't process the queue)
+ *  Emission nodes are pooled by the queue: processed nodes go back to a lock-free free list of tagged indexes
+ *  and keep their arguments capacity, so steady emissions don't allocate
+ *  The queue tracks the connections pushing into it and disconnects them when destroyed,
+ *  thus it must not be destroyed while their senders emit
+*/
+class kF::ObjectUtils::SignalQueue
+{
+    friend class kF::Object;
+
+public:
+    /** @brief Handle of a queued slot */
+    using ConnectionHandle = Meta::SlotTable::OpaqueIndex;
+
+    /** @brief Index of a pooled node */
+    static constexpr std::uint32_t NullNode = std::numeric_limits<std::uint32_t>::max();
+
+    /** @brief Liveness token of a queued connection, its generation changes once the connection is released */
+    struct ConnectionToken
+    {
+        std::uint32_t index { 0u };
+        std::uint32_t generation { 0u };
+    };
+
+    /** @brief A single queued emission
+     *  'nextFree' links released nodes in the pool, 'poolIndex' is NullNode for the stub node */
+    struct Node
+    {
+        std::atomic<Node *> next { nullptr };
+        std::atomic<std::uint32_t> nextFree { NullNode };
+        std::uint32_t poolIndex { NullNode };
+        Meta::SlotTable *slotTable { nullptr };
+        ConnectionHandle handle {};
+        ConnectionToken token {};
+        Core::TinyVector<Var> arguments {};
+    };
+
+    /** @brief Default constructor */
+    SignalQueue(void) noexcept = default;
+
+    /** @brief A queue can't be copied nor moved since producers refer to it */
+    SignalQueue(const SignalQueue &other) = delete;
+    SignalQueue(SignalQueue &&other) = delete;
+
+    /** @brief Destructor, disconnect queued connections and release pending emissions without invoking them */
+    ~SignalQueue(void) noexcept;
+
+
+    /** @brief Queue an emission of a slot from a connection holding 'token', arguments are copied (thread safe) */
+    template<typename ...Args>
+    void push(Meta::SlotTable &slotTable, const ConnectionHandle handle, const ConnectionToken token, const Args &...args);
+
+    /** @brief Invoke up to 'maxCount' pending emissions in push order (consumer thread only)
+     *  Emissions whose connection has been released are dropped, returns the number of processed emissions
+     *  If a slot throws, its emission is released and the exception is propagated */
+    std::size_t processQueued(const std::size_t maxCount = std::numeric_limits<std::size_t>::max());
+
+    /** @brief Check if there is no pending emission (consumer thread only) */
+    [[nodiscard]] bool empty(void) const noexcept
+        { return _tail == &_stub && !_stub.next.load(std::memory_order_acquire); }
+
+private:
+    /** @brief Nodes are allocated by blocks that never move, block 'i' holding 'FirstBlockSize << i' nodes */
+    static constexpr std::uint32_t FirstBlockSize = 64u;
+    static constexpr std::uint32_t MaxBlockCount = std::numeric_limits<std::uint32_t>::digits - std::countr_zero(FirstBlockSize) + 1u;
+
+    /** @brief Tagged index of the first free node, the tag is incremented on each change to prevent ABA */
+    static constexpr std::uint64_t MakeFreeHead(const std::uint32_t index, const std::uint32_t tag) noexcept
+        { return (static_cast<std::uint64_t>(tag) << 32u) | index; }
+
+    alignas_cacheline std::atomic<Node *> _head { &_stub };
+    alignas_cacheline Node *_tail { &_stub };
+    Node _stub {};
+    alignas_cacheline std::atomic<std::uint64_t> _freeHead { MakeFreeHead(NullNode, 0u) };
+    std::atomic<std::uint32_t> _nodeCount { 0u };
+    std::atomic<Node *> _blocks[MaxBlockCount] {};
+
+    /** @brief A queued connection pushing into the queue */
+    struct TrackedConnection
+    {
+        Object *sender { nullptr };
+        Meta::SlotTable *slotTable { nullptr };
+        ConnectionHandle handle {};
+        ConnectionToken token {};
+    };
+
+    Core::Vector<TrackedConnection, std::uint32_t> _connections {};
+    Core::Vector<std::uint32_t, std::uint32_t> _tokenGenerations {};
+    Core::Vector<std::uint32_t, std::uint32_t> _freeTokens {};
+
+    /** @brief Get a liveness token for a new connection */
+    [[nodiscard]] ConnectionToken acquireToken(void) noexcept;
+
+    /** @brief Track a queued connection of a sender holding 'token', returns its position */
+    [[nodiscard]] std::uint32_t trackConnection(Object &sender, Meta::SlotTable &slotTable, const ConnectionHandle handle,
+            const ConnectionToken token) noexcept;
+
+    /** @brief Stop tracking a queued connection and release its token, the last tracked connection takes its position */
+    void untrackConnection(const std::uint32_t position) noexcept;
+
+    /** @brief Check if a connection token hasn't been released (consumer thread only) */
+    [[nodiscard]] bool isTokenLive(const ConnectionToken token) const noexcept
+        { return token.index < _tokenGenerations.size() && _tokenGenerations[token.index] == token.generation; }
+
+    /** @brief Get a pooled node, either a released one or a never used one (thread safe) */
+    [[nodiscard]] Node *acquireNode(void);
+
+    /** @brief Give a processed node back to the pool, keeping its arguments capacity (consumer thread only) */
+    void releaseNode(Node * const node) noexcept;
+
+    /** @brief Get a pooled node from its index, allocating its block if needed (thread safe) */
+    [[nodiscard]] Node *nodeAt(const std::uint32_t index);
+
+    /** @brief Release a node when processing it ends, even by an exception */
+    struct NodeGuard
+    {
+        SignalQueue &queue;
+        Node * const node;
+
+        ~NodeGuard(void) noexcept { queue.releaseNode(node); }
+    };
+
+    /** @brief Link a node at the end of the queue */
+    void pushNode(Node * const node) noexcept;
+
+    /** @brief Unlink the first node of the queue (null if empty or if a producer is still linking it) */
+    [[nodiscard]] Node *popNode(void) noexcept;
+};
+
+#include "SignalQueue.ipp"
@@ -0,0 +1,146 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Queue of signal emissions delivered on a consumer thread
+ */
+
+template<typename ...Args>
+inline void kF::ObjectUtils::SignalQueue::push(Meta::SlotTable &slotTable, const ConnectionHandle handle, const ConnectionToken token, const Args &...args)
+{
+    const auto node = acquireNode();
+
+    node->slotTable = &slotTable;
+    node->handle = handle;
+    node->token = token;
+    if constexpr (sizeof...(Args) != 0) {
+        node->arguments.reserve(sizeof...(Args));
+        (node->arguments.push(Var::Assign(Args(args))), ...);
+    }
+    pushNode(node);
+}
+
+inline kF::ObjectUtils::SignalQueue::ConnectionToken kF::ObjectUtils::SignalQueue::acquireToken(void) noexcept
+{
+    // Released tokens already hold a new generation
+    if (!_freeTokens.empty()) {
+        const auto index = _freeTokens.back();
+        _freeTokens.pop();
+        return ConnectionToken { index: index, generation: _tokenGenerations[index] };
+    }
+    _tokenGenerations.push(0u);
+    return ConnectionToken { index: _tokenGenerations.size() - 1u, generation: 0u };
+}
+
+inline std::uint32_t kF::ObjectUtils::SignalQueue::trackConnection(Object &sender, Meta::SlotTable &slotTable, const ConnectionHandle handle,
+        const ConnectionToken token) noexcept
+{
+    _connections.push(TrackedConnection {
+        sender: &sender,
+        slotTable: &slotTable,
+        handle: handle,
+        token: token
+    });
+    return _connections.size() - 1u;
+}
+
+inline std::size_t kF::ObjectUtils::SignalQueue::processQueued(const std::size_t maxCount)
+{
+    std::size_t count = 0u;
+
+    while (count != maxCount) {
+        const auto node = popNode();
+        if (!node) [[unlikely]]
+            break;
+        const NodeGuard guard { queue: *this, node: node };
+        ++count;
+        // The connection may have been released and its slot handle reused since the emission
+        if (isTokenLive(node->token)) [[likely]]
+            node->slotTable->invoke(node->handle, node->arguments.data());
+    }
+    return count;
+}
+
+inline kF::ObjectUtils::SignalQueue::Node *kF::ObjectUtils::SignalQueue::acquireNode(void)
+{
+    auto head = _freeHead.load(std::memory_order_acquire);
+
+    while (true) {
+        const auto index = static_cast<std::uint32_t>(head);
+        if (index == NullNode) [[unlikely]]
+            break;
+        // Blocks never move, so a node popped concurrently by another producer can still be read
+        const auto node = nodeAt(index);
+        const auto next = node->nextFree.load(std::memory_order_relaxed);
+        if (_freeHead.compare_exchange_weak(head, MakeFreeHead(next, static_cast<std::uint32_t>(head >> 32u) + 1u),
+                std::memory_order_acquire, std::memory_order_acquire)) [[likely]]
+            return node;
+    }
+    return nodeAt(_nodeCount.fetch_add(1u, std::memory_order_relaxed));
+}
+
+inline void kF::ObjectUtils::SignalQueue::releaseNode(Node * const node) noexcept
+{
+    auto head = _freeHead.load(std::memory_order_relaxed);
+
+    node->arguments.clear();
+    do {
+        node->nextFree.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+    } while (!_freeHead.compare_exchange_weak(head, MakeFreeHead(node->poolIndex, static_cast<std::uint32_t>(head >> 32u) + 1u),
+            std::memory_order_release, std::memory_order_relaxed));
+}
+
+inline kF::ObjectUtils::SignalQueue::Node *kF::ObjectUtils::SignalQueue::nodeAt(const std::uint32_t index)
+{
+    const auto block = static_cast<std::uint32_t>(std::bit_width(index / FirstBlockSize + 1u)) - 1u;
+    const auto offset = index - FirstBlockSize * ((1u << block) - 1u);
+    auto nodes = _blocks[block].load(std::memory_order_acquire);
+
+    // The first producer reaching an unallocated block publishes it
+    if (!nodes) [[unlikely]] {
+        const auto size = FirstBlockSize << block;
+        const auto allocated = new Node[size];
+        for (std::uint32_t i = 0u; i != size; ++i)
+            allocated[i].poolIndex = FirstBlockSize * ((1u << block) - 1u) + i;
+        if (_blocks[block].compare_exchange_strong(nodes, allocated, std::memory_order_acq_rel, std::memory_order_acquire))
+            nodes = allocated;
+        else
+            delete[] allocated;
+    }
+    return nodes + offset;
+}
+
+inline void kF::ObjectUtils::SignalQueue::pushNode(Node * const node) noexcept
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    const auto previous = _head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+inline kF::ObjectUtils::SignalQueue::Node *kF::ObjectUtils::SignalQueue::popNode(void) noexcept
+{
+    auto tail = _tail;
+    auto next = tail->next.load(std::memory_order_acquire);
+
+    // Skip the stub node
+    if (tail == &_stub) {
+        if (!next)
+            return nullptr;
+        _tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) [[likely]] {
+        _tail = next;
+        return tail;
+    }
+    // A producer is still linking its node after 'tail'
+    if (tail != _head.load(std::memory_order_acquire)) [[unlikely]]
+        return nullptr;
+    // 'tail' is the last node, put the stub back behind it so it can be unlinked
+    pushNode(&_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) [[likely]] {
+        _tail = next;
+        return tail;
+    }
+    return nullptr;
+}
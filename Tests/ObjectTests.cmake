@@ -3,6 +3,7 @@ project(KubeObjectTests)
 get_filename_component(KubeObjectTestsDir ${CMAKE_CURRENT_LIST_FILE} PATH)
 
 set(KubeObjectTestsSources
+    ${KubeObjectTestsDir}/tests_EventDispatcher.cpp
     ${KubeObjectTestsDir}/tests_ObjectSignal.cpp
     ${KubeObjectTestsDir}/tests_ObjectTree.cpp
     ${KubeObjectTestsDir}/tests_TemplateReflection.cpp
@@ -21,4 +22,26 @@ PUBLIC
 if(KF_COVERAGE)
     target_compile_options(${PROJECT_NAME} PUBLIC --coverage)
     target_link_options(${PROJECT_NAME} PUBLIC --coverage)
+endif()
+
+# Run the whole suite a second time against the compact tree layout
+if(NOT KF_OBJECT_COMPACT_TREE)
+    add_library(KubeObjectCompact ${KubeObjectSources})
+
+    target_link_libraries(KubeObjectCompact
+    PUBLIC
+        KubeMeta
+    )
+
+    target_compile_definitions(KubeObjectCompact PUBLIC KUBE_OBJECT_COMPACT_TREE)
+
+    add_executable(${CMAKE_PROJECT_NAME}Compact ${KubeObjectTestsSources})
+
+    add_test(NAME ${CMAKE_PROJECT_NAME}Compact COMMAND ${CMAKE_PROJECT_NAME}Compact)
+
+    target_link_libraries(${CMAKE_PROJECT_NAME}Compact
+    PUBLIC
+        KubeObjectCompact
+        GTest::GTest GTest::Main
+    )
 endif()
\ No newline at end of file
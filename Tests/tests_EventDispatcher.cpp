@@ -0,0 +1,176 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of EventDispatcher
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Object/Object.hpp>
+#include <Kube/Object/EventDispatcher.hpp>
+
+using namespace kF;
+using namespace kF::Literal;
+using namespace kF::ObjectUtils;
+
+class MouseObject : public Object
+{
+public:
+    ObjectFlags getObjectFlags(void) const noexcept override { return ObjectFlags::MouseHandler; }
+};
+
+TEST(EventDispatcher, Dispatch)
+{
+    Tree tree;
+    MouseObject root, mouse1, mouse2;
+    Object container;
+    EventDispatcher dispatcher(tree, Tree::Flags::MouseHandler);
+    std::vector<Object *> visited;
+    const auto collect = [&visited](Object &object, const Tree::Index, const EventDispatcher::Phase) { visited.push_back(&object); };
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    container.parent(root);
+    mouse1.parent(container);
+    mouse2.parent(root);
+
+    ASSERT_EQ(dispatcher.handlers().size(), 3u);
+    ASSERT_EQ(dispatcher.dispatch(collect, EventDispatcher::Phase::Capture), Tree::NullIndex);
+    ASSERT_EQ(visited, (std::vector<Object *> { &root, &mouse1, &mouse2 }));
+    visited.clear();
+    dispatcher.dispatch(collect);
+    ASSERT_EQ(visited, (std::vector<Object *> { &mouse2, &mouse1, &root }));
+
+    container.enabled(false);
+    visited.clear();
+    dispatcher.dispatch(collect);
+    ASSERT_EQ(visited, (std::vector<Object *> { &mouse2, &root }));
+    container.enabled(true);
+
+    const auto consumer = dispatcher.dispatch([](Object &object, const Tree::Index, const EventDispatcher::Phase) {
+        return object.parent() != nullptr;
+    });
+    ASSERT_EQ(consumer, mouse2.objectIndex());
+}
+
+TEST(EventDispatcher, DispatchTo)
+{
+    Tree tree;
+    MouseObject root, mouse;
+    Object container, target;
+    EventDispatcher dispatcher(tree, Tree::Flags::MouseHandler);
+    std::vector<std::pair<Object *, EventDispatcher::Phase>> visited;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    container.parent(root);
+    mouse.parent(container);
+    target.parent(mouse);
+
+    const auto consumer = dispatcher.dispatchTo(target.objectIndex(),
+        [&visited, &mouse](Object &object, const Tree::Index, const EventDispatcher::Phase phase) {
+            visited.emplace_back(&object, phase);
+            return &object == &mouse && phase == EventDispatcher::Phase::Bubble;
+        }
+    );
+    ASSERT_EQ(consumer, mouse.objectIndex());
+    ASSERT_EQ(visited.size(), 3u);
+    ASSERT_EQ(visited[0], std::make_pair(static_cast<Object *>(&root), EventDispatcher::Phase::Capture));
+    ASSERT_EQ(visited[1], std::make_pair(static_cast<Object *>(&mouse), EventDispatcher::Phase::Capture));
+    ASSERT_EQ(visited[2], std::make_pair(static_cast<Object *>(&mouse), EventDispatcher::Phase::Bubble));
+
+    container.enabled(false);
+    ASSERT_EQ(dispatcher.dispatchTo(target.objectIndex(), [](Object &, const Tree::Index, const EventDispatcher::Phase) { return true; }), Tree::NullIndex);
+}
+
+TEST(EventDispatcher, ReentrantDispatch)
+{
+    Tree tree;
+    MouseObject root, mouse1, mouse2;
+    EventDispatcher dispatcher(tree, Tree::Flags::MouseHandler);
+    std::vector<Object *> visited;
+    std::vector<Object *> nestedVisited;
+    tree.setFlagIndexed(Tree::Flags::MouseHandler, true);
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    mouse1.parent(root);
+    mouse2.parent(root);
+
+    // Visibility doesn't change the handler list
+    mouse1.visible(false);
+    ASSERT_EQ(dispatcher.handlers().size(), 3u);
+
+    // The root handler removes the last handler then dispatches again
+    dispatcher.dispatch([&](Object &object, const Tree::Index, const EventDispatcher::Phase) {
+        visited.push_back(&object);
+        if (&object != &root)
+            return;
+        mouse2.removeFromTree();
+        dispatcher.dispatch([&nestedVisited](Object &nestedObject, const Tree::Index, const EventDispatcher::Phase) {
+            nestedVisited.push_back(&nestedObject);
+        }, EventDispatcher::Phase::Capture);
+    }, EventDispatcher::Phase::Capture);
+    ASSERT_EQ(visited, (std::vector<Object *> { &root, &mouse1 }));
+    ASSERT_EQ(nestedVisited, (std::vector<Object *> { &root, &mouse1 }));
+}
+
+TEST(EventDispatcher, IncrementalUpdate)
+{
+    Tree tree;
+    MouseObject root, mouse1, mouse2, mouse3;
+    Object container;
+    EventDispatcher dispatcher(tree, Tree::Flags::MouseHandler);
+    const auto expectHandlers = [&tree, &dispatcher] {
+        EventDispatcher fresh(tree, Tree::Flags::MouseHandler);
+        const auto &patched = dispatcher.handlers();
+        const auto &rebuilt = fresh.handlers();
+        ASSERT_EQ(std::vector<Tree::Index>(patched.begin(), patched.end()), std::vector<Tree::Index>(rebuilt.begin(), rebuilt.end()));
+    };
+    tree.setJournaled(true);
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    container.parent(root);
+    mouse1.parent(container);
+    mouse2.parent(root);
+    ASSERT_EQ(dispatcher.handlers().size(), 3u);
+
+    // Changes are patched from the journal in tree order
+    mouse3.parent(container);
+    expectHandlers();
+    mouse2.parent(mouse1);
+    expectHandlers();
+    container.enabled(false);
+    ASSERT_EQ(dispatcher.handlers().size(), 1u);
+    container.enabled(true);
+    expectHandlers();
+    tree.setChildOrderStable(false);
+    mouse1.removeFromTree();
+    expectHandlers();
+    mouse1.parent(root);
+    expectHandlers();
+
+    // Without journal, the list is rebuilt on topology changes only
+    tree.setJournaled(false);
+    root.id("other"_hash);
+    expectHandlers();
+    mouse3.parent(root);
+    expectHandlers();
+}
+
+TEST(EventDispatcher, SlotReuseDuringDispatch)
+{
+    Tree tree;
+    MouseObject root, mouse1, mouse2;
+    EventDispatcher dispatcher(tree, Tree::Flags::MouseHandler);
+    std::vector<Object *> visited;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    mouse1.parent(root);
+
+    // The root handler removes the last handler and another one takes its slot
+    dispatcher.dispatch([&](Object &object, const Tree::Index, const EventDispatcher::Phase) {
+        visited.push_back(&object);
+        if (&object != &root)
+            return;
+        const auto index = mouse1.objectIndex();
+        mouse1.removeFromTree();
+        mouse2.parent(root);
+        ASSERT_EQ(mouse2.objectIndex(), index);
+    }, EventDispatcher::Phase::Capture);
+    ASSERT_EQ(visited, (std::vector<Object *> { &root }));
+    ASSERT_EQ(dispatcher.handlers().size(), 2u);
+}
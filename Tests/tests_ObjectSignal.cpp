@@ -4,6 +4,9 @@
  */
 
 #include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -198,4 +201,295 @@ TEST(Object, ConnectionMultiple)
         ASSERT_EQ(x, ++y);
     }
     receiver.disconnect();
-}
\ No newline at end of file
+}
+
+TEST(Object, SignalBuckets)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    BasicFoo foo;
+    int data = 0, value = 0;
+    foo.connect<&BasicFoo::dataChanged>([&data] { ++data; });
+    auto conn = foo.connect<&BasicFoo::signal>([&value](int x) { value += x; });
+    foo.connect<&BasicFoo::dataChanged>([&data] { ++data; });
+    foo.connect<&BasicFoo::signal>([&value](int x) { value += x * 10; });
+    emit foo.signal(1);
+    ASSERT_EQ(value, 11);
+    ASSERT_EQ(data, 0);
+    emit foo.dataChanged();
+    ASSERT_EQ(value, 11);
+    ASSERT_EQ(data, 2);
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::signal>(conn));
+    ASSERT_FALSE(foo.disconnect<&BasicFoo::signal>(conn));
+    emit foo.signal(1);
+    ASSERT_EQ(value, 21);
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::dataChanged>());
+    ASSERT_FALSE(foo.disconnect<&BasicFoo::dataChanged>());
+    emit foo.dataChanged();
+    ASSERT_EQ(data, 2);
+    emit foo.signal(1);
+    ASSERT_EQ(value, 31);
+
+    // Disconnected entries are dropped without emitting, remaining slots keep their order
+    Object::ConnectionHandle handles[8];
+    int order = 0;
+    for (int i = 0; i != 8; ++i)
+        handles[i] = foo.connect<&BasicFoo::signalSet>([&order, i](int &, int) { order = order * 10 + i; });
+    for (int i = 0; i != 8; i += 2)
+        ASSERT_TRUE(foo.disconnect<&BasicFoo::signalSet>(handles[i]));
+    foo.connect<&BasicFoo::signalSet>([&order](int &, int) { order = order * 10 + 8; });
+    emit foo.signalSet(value, 0);
+    ASSERT_EQ(order, 13578);
+}
+
+TEST(Object, QueuedConnection)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    ObjectUtils::SignalQueue queue;
+    BasicFoo foo;
+    int value = 0, direct = 0;
+    foo.connectQueued<&BasicFoo::signal>(queue, [&value](int x) { value += x; });
+    foo.connect<&BasicFoo::signal>([&direct](int x) { direct += x; });
+    std::thread worker([&foo] {
+        for (int i = 1; i <= 100; ++i)
+            emit foo.signal(i);
+    });
+    worker.join();
+    ASSERT_EQ(value, 0);
+    ASSERT_EQ(direct, 5050);
+    ASSERT_EQ(queue.processQueued(50), 50);
+    ASSERT_EQ(value, 1275);
+    ASSERT_EQ(queue.processQueued(), 50);
+    ASSERT_EQ(value, 5050);
+    ASSERT_TRUE(queue.empty());
+
+    // Disconnected queued slots drop their pending emissions
+    auto conn = foo.connectQueued<&BasicFoo::signal>(queue, [&value](int x) { value -= x; });
+    emit foo.signal(1);
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::signal>(conn));
+    emit foo.signal(1);
+    queue.processQueued();
+    ASSERT_EQ(value, 5052);
+
+    // Destroying a queue disconnects the queued slots pushing into it
+    {
+        ObjectUtils::SignalQueue transient;
+        foo.connectQueued<&BasicFoo::signal>(transient, [&value](int x) { value += x * 100; });
+        emit foo.signal(1);
+    }
+    emit foo.signal(1);
+    queue.processQueued();
+    ASSERT_EQ(value, 5054);
+
+    // Emissions of a released connection are dropped, even if a new connection reuses its slot handle
+    const auto released = foo.connectQueued<&BasicFoo::signal>(queue, [&value](int x) { value += x * 1000; });
+    emit foo.signal(1);
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::signal>(released));
+    foo.connectQueued<&BasicFoo::signal>(queue, [&value](int x) { value += x * 10; });
+    ASSERT_EQ(queue.processQueued(), 2u);
+    ASSERT_EQ(value, 5055);
+    emit foo.signal(1);
+    queue.processQueued();
+    ASSERT_EQ(value, 5066);
+}
+
+TEST(Object, TypedConnection)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    BasicFoo foo;
+    int value = 0, x = 0;
+    auto conn = foo.connectTyped<&BasicFoo::signal>([&value](int v) { value += v; });
+    foo.connectTyped<&BasicFoo::signalIncrement>(foo, &BasicFoo::incrementValue);
+    foo.connectTyped<&BasicFoo::dataChanged>([&value] { value = -value; });
+
+    // Typed emission paths
+    emit foo.signal(1);
+    foo.emitSignal<&BasicFoo::signal>(2);
+    ASSERT_EQ(value, 3);
+    emit foo.signalIncrement(x);
+    ASSERT_EQ(x, 1);
+    foo.data(42);
+    ASSERT_EQ(value, -3);
+
+    // Boxed emission paths still reach typed slots
+    foo.emitSignal("signal"_hash, 4);
+    ASSERT_EQ(value, 1);
+    foo.emitSignal("signalIncrement"_hash, x);
+    ASSERT_EQ(x, 2);
+
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::signal>(conn));
+    emit foo.signal(1);
+    foo.emitSignal("signal"_hash, 1);
+    ASSERT_EQ(value, 1);
+}
+
+TEST(Object, ReceiverTeardown)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    BasicFoo foo;
+    int x = 0, y = 0, value = 0;
+    Object::ConnectionHandle conn;
+    {
+        BasicFoo receiver;
+        conn = foo.connect<&BasicFoo::signalSet>(receiver, &BasicFoo::setValue);
+        foo.connectTyped<&BasicFoo::signalIncrement>(receiver, &BasicFoo::incrementValue);
+        emit foo.signalSet(y, 42);
+        emit foo.signalIncrement(x);
+        ASSERT_EQ(y, 42);
+        ASSERT_EQ(x, 1);
+    }
+    // Destroying the receiver released every connection it owned
+    emit foo.signalSet(y, 24);
+    emit foo.signalIncrement(x);
+    ASSERT_EQ(y, 42);
+    ASSERT_EQ(x, 1);
+    ASSERT_FALSE(foo.disconnect<&BasicFoo::signalSet>(conn));
+
+    // Disconnecting in the middle of a bucket keeps the others in order
+    Object::ConnectionHandle handles[4];
+    for (int i = 0; i != 4; ++i)
+        handles[i] = foo.connect<&BasicFoo::signal>([&value, i](int v) { value = value * 10 + i + v; });
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::signal>(handles[1]));
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::signal>(handles[2]));
+    emit foo.signal(1);
+    ASSERT_EQ(value, 14);
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::signal>(handles[3]));
+    emit foo.signal(1);
+    ASSERT_EQ(value, 141);
+}
+
+TEST(Object, ReentrantConnection)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    BasicFoo foo;
+    int value = 0, data = 0, count = 0, x = 0;
+
+    // Slots may register new signals while being called
+    foo.connect<&BasicFoo::signal>([&foo, &value, &data](int v) {
+        value += v;
+        foo.connect<&BasicFoo::dataChanged>([&data] { ++data; });
+        foo.connect<&BasicFoo::parentChanged>([] {});
+        foo.connect<&BasicFoo::enabledChanged>([] {});
+        foo.connect<&BasicFoo::visibleChanged>([] {});
+    });
+    foo.connect<&BasicFoo::signal>([&value](int v) { value += v * 10; });
+    emit foo.signal(1);
+    ASSERT_EQ(value, 11);
+    emit foo.dataChanged();
+    ASSERT_EQ(data, 1);
+
+    // Slots may disconnect their own signal while being called
+    for (int i = 0; i != 4; ++i) {
+        foo.connect<&BasicFoo::signalIncrement>([&foo, &count](int &) {
+            ++count;
+            foo.disconnect<&BasicFoo::signalIncrement>();
+        });
+    }
+    emit foo.signalIncrement(x);
+    ASSERT_EQ(count, 1);
+    emit foo.signalIncrement(x);
+    ASSERT_EQ(count, 1);
+
+    // Typed slots may disconnect themselves while being called, their captures stay alive until they return
+    Object::ConnectionHandle self;
+    int typed = 0;
+    self = foo.connectTyped<&BasicFoo::signalIncrement>([&foo, &self, &typed, captured = std::vector<int>(64, 1)](int &) {
+        foo.disconnect<&BasicFoo::signalIncrement>(self);
+        typed += captured.back();
+    });
+    foo.connectTyped<&BasicFoo::signalIncrement>([&typed](int &) { typed += 10; });
+    emit foo.signalIncrement(x);
+    ASSERT_EQ(typed, 11);
+    emit foo.signalIncrement(x);
+    ASSERT_EQ(typed, 21);
+    foo.disconnect();
+    emit foo.signalIncrement(x);
+    ASSERT_EQ(typed, 21);
+}
+
+TEST(Object, SignalBatch)
+{
+    Meta::Resolver::Clear();
+    RegisterMetadata();
+
+    BasicFoo foo, foo2;
+    int changed = 0, changed2 = 0, value = 0;
+    foo.connect<&BasicFoo::dataChanged>([&changed] { ++changed; });
+    foo2.connectTyped<&BasicFoo::dataChanged>([&changed2, &foo2] { changed2 += foo2.data(); });
+    foo.connect<&BasicFoo::signal>([&value](int x) { value += x; });
+    {
+        ObjectUtils::SignalBatch batch;
+        for (int i = 1; i <= 10; ++i) {
+            foo.data(i);
+            foo2.data(i);
+            emit foo.signal(i);
+        }
+        {
+            ObjectUtils::SignalBatch nested;
+            foo.data(42);
+        }
+        // Signals with arguments are never deferred
+        ASSERT_EQ(value, 55);
+        ASSERT_EQ(changed, 0);
+        ASSERT_EQ(changed2, 0);
+        ASSERT_EQ(batch.count(), 2u);
+    }
+    // Each signal is emitted once, observing the latest state
+    ASSERT_EQ(changed, 1);
+    ASSERT_EQ(changed2, 10);
+    foo.data(0);
+    ASSERT_EQ(changed, 2);
+
+    // Objects destroyed inside a batch are not emitted
+    {
+        ObjectUtils::SignalBatch batch;
+        BasicFoo foo3;
+        foo3.connect<&BasicFoo::dataChanged>([&changed] { ++changed; });
+        foo3.data(1);
+        foo.data(1);
+    }
+    ASSERT_EQ(changed, 3);
+
+    // Emissions through distinct slot tables are recorded separately
+    Meta::SlotTable slotTable;
+    int custom = 0;
+    foo.connect<&BasicFoo::dataChanged>(slotTable, [&custom] { ++custom; });
+    {
+        ObjectUtils::SignalBatch batch;
+        foo.data(2);
+        foo.emitSignal<&BasicFoo::dataChanged>(slotTable);
+        foo.emitSignal<&BasicFoo::dataChanged>(slotTable);
+        ASSERT_EQ(batch.count(), 2u);
+    }
+    ASSERT_EQ(changed, 4);
+    ASSERT_EQ(custom, 1);
+    ASSERT_TRUE(foo.disconnect<&BasicFoo::dataChanged>(slotTable));
+
+    // An explicit flush propagates exceptions of slots, following emissions stay recorded
+    BasicFoo thrower;
+    thrower.connect<&BasicFoo::dataChanged>([] { throw std::runtime_error("dataChanged"); });
+    {
+        ObjectUtils::SignalBatch batch;
+        thrower.data(1);
+        foo.data(2);
+        ASSERT_THROW(batch.flush(), std::runtime_error);
+        ASSERT_TRUE(batch.isRecording());
+        ASSERT_EQ(batch.count(), 1u);
+        ASSERT_EQ(changed, 4);
+        batch.flush();
+        ASSERT_EQ(batch.count(), 0u);
+        ASSERT_EQ(changed, 5);
+        foo.data(3);
+        ASSERT_EQ(changed, 5);
+    }
+    ASSERT_EQ(changed, 6);
+}
@@ -3,11 +3,16 @@
  * @ Description: Unit tests of ObjectTree
  */
 
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include <Kube/Object/Object.hpp>
+#include <Kube/Object/TreeSnapshot.hpp>
+#include <Kube/Object/TreeParallel.hpp>
 
 using namespace kF;
 using namespace kF::Literal;
@@ -97,4 +102,629 @@ TEST(Object, BasicTree)
     ASSERT_EQ(subchild.findGlobal("child1"_hash), &child1);
     ASSERT_EQ(subchild.findGlobal("child2"_hash), &child2);
     ASSERT_EQ(subchild.findGlobal("subchild"_hash), &subchild);
-}
\ No newline at end of file
+}
+
+TEST(Object, IndexedTree)
+{
+    Tree tree;
+    Object root, child1, child2;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child1.parent(root, "child1"_hash);
+    tree.setIdIndexed(true);
+    ASSERT_TRUE(tree.isIdIndexed());
+    child2.parent(root, "child2"_hash);
+
+    ASSERT_EQ(root.findGlobal("root"_hash), &root);
+    ASSERT_EQ(root.findGlobal("child1"_hash), &child1);
+    ASSERT_EQ(root.findGlobal("child2"_hash), &child2);
+
+    child1.id("renamed"_hash);
+    ASSERT_EQ(root.findGlobal("child1"_hash), nullptr);
+    ASSERT_EQ(root.findGlobal("renamed"_hash), &child1);
+
+    child2.removeFromTree();
+    ASSERT_EQ(root.findGlobal("child2"_hash), nullptr);
+    ASSERT_EQ(tree.findLinear("child2"_hash), Tree::NullIndex);
+
+    tree.setIdIndexed(false);
+    ASSERT_FALSE(tree.isIdIndexed());
+    ASSERT_EQ(root.findGlobal("renamed"_hash), &child1);
+}
+
+TEST(Object, CompactTree)
+{
+    Tree tree;
+    Object root, child1, child2, subchild1, subchild2;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child1.parent(root, "child1"_hash);
+    auto temporary = std::make_unique<Object>(root, "temporary"_hash);
+    child2.parent(root, "child2"_hash);
+    subchild2.parent(child2, "subchild2"_hash);
+    subchild1.parent(child1, "subchild1"_hash);
+    temporary.reset();
+
+    const auto remap = tree.compact();
+    ASSERT_EQ(remap.size(), 7u);
+    ASSERT_EQ(tree.nodeCount(), 6u);
+    ASSERT_EQ(tree.get(1u).object, &root);
+    ASSERT_EQ(tree.get(2u).object, &child1);
+    ASSERT_EQ(tree.get(3u).object, &subchild1);
+    ASSERT_EQ(tree.get(4u).object, &child2);
+    ASSERT_EQ(tree.get(5u).object, &subchild2);
+    ASSERT_EQ(subchild2.parent(), &child2);
+    ASSERT_EQ(child2.parent(), &root);
+    ASSERT_EQ(root.getChild(1u), &child2);
+    ASSERT_EQ(subchild1.find("child2"_hash), &child2);
+    ASSERT_EQ(root.findGlobal("subchild2"_hash), &subchild2);
+}
+
+TEST(Object, DirtyTree)
+{
+    Tree tree;
+    Object root, child, subchild;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child.parent(root, "child"_hash);
+    ASSERT_TRUE(tree.isTreeDirty());
+    tree.setTreeDirtyFlag(false);
+    tree.setEnabledDirtyFlag(false);
+    tree.setVisibleDirtyFlag(false);
+
+    subchild.parent(child, "subchild"_hash);
+    ASSERT_EQ(tree.treeDirtyRoots().size(), 1u);
+    ASSERT_EQ(tree.get(tree.treeDirtyRoots()[0]).object, &child);
+    tree.setTreeDirtyFlag(false);
+    tree.setEnabledDirtyFlag(false);
+    tree.setVisibleDirtyFlag(false);
+
+    subchild.visible(false);
+    ASSERT_FALSE(tree.isTreeDirty());
+    ASSERT_FALSE(tree.isEnabledDirty());
+    ASSERT_EQ(tree.visibleDirtyRoots().size(), 1u);
+    ASSERT_EQ(tree.get(tree.visibleDirtyRoots()[0]).object, &subchild);
+    child.enabled(false);
+    ASSERT_EQ(tree.enabledDirtyRoots().size(), 1u);
+    ASSERT_EQ(tree.get(tree.enabledDirtyRoots()[0]).object, &child);
+}
+
+class DrawObject : public Object
+{
+public:
+    ObjectFlags getObjectFlags(void) const noexcept override { return ObjectFlags::DrawHandler; }
+};
+
+TEST(Object, FlagIndexedTree)
+{
+    Tree tree;
+    Object root, child;
+    DrawObject draw1, draw2, draw3;
+    tree.setFlagIndexed(Tree::Flags::DrawHandler, true);
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    draw1.parent(root);
+    child.parent(root);
+    draw2.parent(child);
+    draw3.parent(root);
+    ASSERT_EQ(tree.flaggedCount(Tree::Flags::DrawHandler), 3u);
+
+    std::vector<Object *> objects;
+    tree.forEachFlagged(Tree::Flags::DrawHandler, [&tree, &objects](const Tree::Index index) {
+        objects.push_back(tree.get(index).object);
+    });
+    ASSERT_EQ(objects, (std::vector<Object *> { &draw1, &draw2, &draw3 }));
+
+    draw2.removeFromTree();
+    ASSERT_EQ(tree.flaggedCount(Tree::Flags::DrawHandler), 2u);
+    draw3.parent(child);
+    objects.clear();
+    tree.forEachFlagged(Tree::Flags::DrawHandler, [&tree, &objects](const Tree::Index index) {
+        objects.push_back(tree.get(index).object);
+    });
+    ASSERT_EQ(objects, (std::vector<Object *> { &draw1, &draw3 }));
+}
+
+TEST(Object, FlagIndexedBatch)
+{
+    Tree tree;
+    tree.setFlagIndexed(Tree::Flags::DrawHandler, true);
+    const auto parent = tree.add(Tree::RootIndex, nullptr, "parent"_hash, Tree::Flags::DrawHandler);
+    Tree::BatchNode nodes[] {
+        { id: "a"_hash, flags: Tree::Flags::DrawHandler },
+        { id: "b"_hash, parent: 0u, flags: Tree::Flags::DrawHandler },
+        { id: "c"_hash, parent: 1u },
+        { id: "d"_hash, parent: 2u, flags: Tree::Flags::DrawHandler },
+        { id: "e"_hash }
+    };
+    const auto indexes = tree.addBatch(parent, std::begin(nodes), std::end(nodes));
+    ASSERT_EQ(tree.flaggedCount(Tree::Flags::DrawHandler), 4u);
+    ASSERT_EQ(tree.flaggedCount(Tree::Flags::DrawHandler, parent), 4u);
+    ASSERT_EQ(tree.flaggedCount(Tree::Flags::DrawHandler, indexes[0]), 3u);
+    ASSERT_EQ(tree.flaggedCount(Tree::Flags::DrawHandler, indexes[2]), 1u);
+    ASSERT_EQ(tree.flaggedCount(Tree::Flags::DrawHandler, indexes[4]), 0u);
+
+    tree.clearDirty(Tree::DirtyType::Flags);
+    tree.setFlags(indexes[4], Tree::Flags::DrawHandler);
+    ASSERT_EQ(tree.flaggedCount(Tree::Flags::DrawHandler), 5u);
+    ASSERT_EQ(tree.flagsDirtyRoots().size(), 1u);
+    ASSERT_EQ(tree.flagsDirtyRoots()[0], indexes[4]);
+}
+
+TEST(Object, EffectiveStates)
+{
+    Tree tree;
+    Object root, child, subchild;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child.parent(root);
+    subchild.parent(child);
+    ASSERT_TRUE(subchild.effectivelyVisible());
+    ASSERT_TRUE(subchild.effectivelyEnabled());
+
+    root.visible(false);
+    ASSERT_TRUE(subchild.visible());
+    ASSERT_FALSE(subchild.effectivelyVisible());
+    ASSERT_TRUE(subchild.effectivelyEnabled());
+
+    child.enabled(false);
+    ASSERT_FALSE(subchild.effectivelyEnabled());
+    ASSERT_TRUE(root.effectivelyEnabled());
+
+    subchild.parent(tree, Tree::RootIndex, 0u);
+    ASSERT_TRUE(subchild.effectivelyVisible());
+    ASSERT_TRUE(subchild.effectivelyEnabled());
+}
+
+TEST(Object, ParallelVisit)
+{
+    constexpr auto Count = 1000u;
+    Tree tree;
+    Object root;
+    std::unique_ptr<Object[]> objects = std::make_unique<Object[]>(Count);
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    for (auto i = 0u; i != Count; ++i) {
+        objects[i].parent(i < 10u ? root : objects[i / 10u - 1u]);
+        objects[i].visible(i % 7u);
+    }
+
+    std::vector<Tree::Index> expected;
+    tree.forEachFlagged(Tree::Flags::None, [&expected](const Tree::Index index) { expected.push_back(index); });
+    for (auto threadCount : { 1u, 2u, 4u }) {
+        const auto all = tree.parallelCollect(Tree::RootIndex, [](const Tree::Index) { return true; }, Tree::VisitFilter {}, threadCount);
+        ASSERT_TRUE(std::equal(all.begin(), all.end(), expected.begin(), expected.end()));
+
+        // Results are only checked on the main thread
+        std::atomic<std::uint32_t> visibleCount { 0u }, hiddenCount { 0u };
+        tree.parallelVisit(Tree::RootIndex, [&visibleCount, &hiddenCount, &tree](const Tree::Index index) {
+            ++(tree.get(index).visible ? visibleCount : hiddenCount);
+        }, Tree::VisitFilter { visibleOnly: true }, threadCount);
+        ASSERT_EQ(hiddenCount.load(), 0u);
+        ASSERT_EQ(visibleCount.load(), tree.parallelCollect(Tree::RootIndex, [](const Tree::Index) { return true; },
+            Tree::VisitFilter { visibleOnly: true }, threadCount).size());
+
+        // Exceptions thrown by any thread are rethrown on the calling one
+        const auto thrower = objects[Count - 1u].objectIndex();
+        ASSERT_THROW(tree.parallelVisit(Tree::RootIndex, [thrower](const Tree::Index index) {
+            if (index == thrower)
+                throw std::runtime_error("ParallelVisit");
+        }, Tree::VisitFilter {}, threadCount), std::runtime_error);
+    }
+}
+
+TEST(Object, BatchTree)
+{
+    Tree tree;
+    Object root, child1, child2, subchild;
+    int rootCount = 0, childCount = 0;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    root.connect<&Object::childrenCountChanged>([&rootCount] { ++rootCount; });
+    child1.connect<&Object::childrenCountChanged>([&childCount] { ++childCount; });
+
+    Tree::BatchNode nodes[] {
+        { object: &child1, id: "child1"_hash },
+        { object: &subchild, id: "subchild"_hash, parent: 0u },
+        { object: &child2, id: "child2"_hash }
+    };
+    Object::ParentBatch(tree, root.objectIndex(), std::begin(nodes), std::end(nodes));
+    ASSERT_EQ(rootCount, 1);
+    ASSERT_EQ(childCount, 1);
+    ASSERT_EQ(root.childrenCount(), 2u);
+    ASSERT_EQ(child1.parent(), &root);
+    ASSERT_EQ(child2.parent(), &root);
+    ASSERT_EQ(subchild.parent(), &child1);
+    ASSERT_EQ(subchild.find("child2"_hash), &child2);
+    ASSERT_EQ(root.findGlobal("subchild"_hash), &subchild);
+}
+
+TEST(Object, RemoveChildren)
+{
+    Tree tree;
+    Object root, child1, child2, subchild;
+    int parentChangedCount = 0;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child1.parent(root, "child1"_hash);
+    child2.parent(root, "child2"_hash);
+    subchild.parent(child1, "subchild"_hash);
+    child1.connect<&Object::parentChanged>([&parentChangedCount] { ++parentChangedCount; });
+
+    root.removeChildrenFromTree();
+    ASSERT_EQ(parentChangedCount, 1);
+    ASSERT_EQ(root.childrenCount(), 0u);
+    ASSERT_FALSE(child1.isInTree());
+    ASSERT_FALSE(child2.isInTree());
+    ASSERT_FALSE(subchild.isInTree());
+    ASSERT_EQ(subchild.parent(), nullptr);
+    ASSERT_EQ(root.findGlobal("subchild"_hash), nullptr);
+
+    child1.parent(root, "child1"_hash);
+    tree.removeSubtree(child1.objectIndex());
+    ASSERT_FALSE(child1.isInTree());
+    ASSERT_EQ(root.childrenCount(), 0u);
+}
+
+TEST(Object, TreeSnapshot)
+{
+    Tree tree;
+    Object root, child1, child2;
+    TreeSnapshotBuffer buffer;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child1.parent(root, "child1"_hash);
+    ASSERT_EQ(buffer.acquire(), nullptr);
+
+    buffer.publish(tree);
+    child2.parent(root, "child2"_hash);
+    root.visible(false);
+    ASSERT_NE(buffer.acquire(), nullptr);
+    const auto &snapshot = *buffer.acquire();
+    ASSERT_EQ(snapshot.version(), 1u);
+    ASSERT_EQ(snapshot.children(root.objectIndex()).size(), 1u);
+    ASSERT_EQ(snapshot.children(root.objectIndex())[0], child1.objectIndex());
+    ASSERT_TRUE(snapshot.effectivelyVisible(child1.objectIndex()));
+
+    buffer.publish(tree);
+    ASSERT_EQ(snapshot.version(), 1u);
+    const auto &next = *buffer.acquire();
+    ASSERT_EQ(next.version(), 2u);
+    ASSERT_EQ(next.children(root.objectIndex()).size(), 2u);
+    ASSERT_EQ(next.id(child2.objectIndex()), "child2"_hash);
+    ASSERT_EQ(next.object(child2.objectIndex()), &child2);
+    ASSERT_FALSE(next.effectivelyVisible(child1.objectIndex()));
+}
+
+TEST(Object, SerializeTree)
+{
+    Tree tree;
+    Object root, child;
+    DrawObject draw;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child.parent(root, "child"_hash);
+    draw.parent(child, "draw"_hash);
+    child.visible(false);
+
+    std::vector<std::uint32_t> data(tree.serializedSize() / sizeof(std::uint32_t));
+    tree.serialize(data.data());
+    const auto size = data.size() * sizeof(std::uint32_t);
+    Tree loaded;
+    ASSERT_FALSE(Object::InstantiateTree(loaded, data.data(), size - sizeof(std::uint32_t), [](HashedName, Tree::Index) -> Object * { return nullptr; }));
+
+    std::vector<std::unique_ptr<Object>> objects;
+    const auto loadedOk = Object::InstantiateTree(loaded, data.data(), size,
+        [&objects, &draw](const HashedName typeName, const Tree::Index) -> Object * {
+            if (typeName == draw.getMetaType().name())
+                return objects.emplace_back(std::make_unique<DrawObject>()).get();
+            return objects.emplace_back(std::make_unique<Object>()).get();
+        }
+    );
+    ASSERT_TRUE(loadedOk);
+    ASSERT_EQ(objects.size(), 3u);
+    ASSERT_EQ(loaded.nodeCount(), tree.nodeCount());
+    const auto loadedRoot = loaded.get(loaded.find("root"_hash)).object;
+    const auto loadedChild = loaded.get(loaded.find("child"_hash)).object;
+    const auto loadedDraw = loaded.get(loaded.find("draw"_hash)).object;
+    ASSERT_EQ(loadedChild->parent(), loadedRoot);
+    ASSERT_EQ(loadedDraw->parent(), loadedChild);
+    ASSERT_EQ(loadedDraw->getObjectFlags(), Tree::Flags::DrawHandler);
+    ASSERT_EQ(loadedRoot->find("child"_hash), loadedChild);
+    ASSERT_FALSE(loadedChild->visible());
+    ASSERT_FALSE(loadedDraw->effectivelyVisible());
+    ASSERT_EQ(loadedRoot->childrenCount(), 1u);
+}
+
+/** @brief Serialize raw topology columns (ids, type names, flags and states are zeroed) */
+static std::vector<std::uint32_t> MakeSerializedTree(const std::vector<Tree::Index> &parents,
+        const std::vector<std::vector<Tree::Index>> &children, const std::vector<Tree::Index> &freeList = {})
+{
+    const auto count = static_cast<Tree::Index>(parents.size());
+    std::vector<std::uint32_t> data { Tree::SerializedMagic, Tree::SerializedVersion, count, 0u, static_cast<Tree::Index>(freeList.size()) };
+    std::vector<Tree::Index> childOffsets { 0u };
+    std::vector<Tree::Index> childIndexes;
+
+    for (const auto &list : children) {
+        childIndexes.insert(childIndexes.end(), list.begin(), list.end());
+        childOffsets.push_back(static_cast<Tree::Index>(childIndexes.size()));
+    }
+    data[3] = static_cast<Tree::Index>(childIndexes.size());
+    data.insert(data.end(), count, 0u);
+    data.insert(data.end(), parents.begin(), parents.end());
+    data.insert(data.end(), count, 0u);
+    data.insert(data.end(), childOffsets.begin(), childOffsets.end());
+    data.insert(data.end(), childIndexes.begin(), childIndexes.end());
+    data.insert(data.end(), freeList.begin(), freeList.end());
+    data.insert(data.end(), (count * (sizeof(Tree::Flags) + 1u) + 3u) / 4u, 0u);
+    return data;
+}
+
+TEST(Object, DeserializeInvalidTree)
+{
+    constexpr auto Null = Tree::NullIndex;
+    const auto load = [](Tree &tree, const std::vector<std::uint32_t> &data) {
+        return tree.deserialize(data.data(), data.size() * sizeof(std::uint32_t));
+    };
+    Tree tree;
+    Object root, child;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child.parent(root, "child"_hash);
+
+    // Valid trees, with an orphan branch and a free slot
+    Tree loaded;
+    ASSERT_TRUE(load(loaded, MakeSerializedTree({ Null, 0u }, { { 1u }, {} })));
+    ASSERT_TRUE(load(loaded, MakeSerializedTree({ Null, Null, 1u, Null }, { {}, { 2u }, {}, {} }, { 3u })));
+    // Root holding a parent
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ 1u, 0u }, { { 1u }, { 0u } })));
+    // Child listed twice
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ Null, 0u }, { { 1u, 1u }, {} })));
+    // Free slot listed in the hierarchy
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ Null, 0u }, { { 1u }, {} }, { 1u })));
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ Null, Null, 1u }, { {}, { 2u }, {} }, { 1u })));
+    // Free slot listed twice
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ Null, Null }, { {}, {} }, { 1u, 1u })));
+    // Parent not listing its child
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ Null, 0u }, { {}, {} })));
+    // Child listed by a node that isn't its parent
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ Null, Null }, { { 1u }, {} })));
+    // Cycle detached from the root
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ Null, 2u, 1u }, { {}, { 2u }, { 1u } })));
+    ASSERT_FALSE(load(tree, MakeSerializedTree({ Null, 1u }, { {}, { 1u } })));
+    // Rejected data leaves the tree untouched
+    ASSERT_EQ(root.find("child"_hash), &child);
+    ASSERT_EQ(tree.nodeCount(), 2u);
+
+    // Accepted data detaches previously bound objects
+    ASSERT_TRUE(load(tree, MakeSerializedTree({ Null }, { {} })));
+    ASSERT_FALSE(root.isInTree());
+    ASSERT_FALSE(child.isInTree());
+}
+
+TEST(Object, ChildOrder)
+{
+    Tree tree;
+    Object root, child1, child2, child3, child4;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child1.parent(root);
+    child2.parent(root);
+    child3.parent(root);
+    child4.parent(root);
+    ASSERT_EQ(tree.childPosition(child3.objectIndex()), 2u);
+
+    child2.removeFromTree();
+    ASSERT_EQ(root.getChild(1u), &child3);
+    ASSERT_EQ(root.getChild(2u), &child4);
+    ASSERT_EQ(tree.childPosition(child4.objectIndex()), 2u);
+
+    tree.setChildOrderStable(false);
+    tree.setJournaled(true);
+    child1.parent(child3);
+    ASSERT_EQ(root.childrenCount(), 2u);
+    ASSERT_EQ(root.getChild(0u), &child4);
+    ASSERT_EQ(root.getChild(1u), &child3);
+    ASSERT_EQ(tree.childPosition(child4.objectIndex()), 0u);
+    ASSERT_EQ(tree.childPosition(child1.objectIndex()), 0u);
+    ASSERT_EQ(child1.parent(), &child3);
+    // The sibling filling the hole is journaled as moved
+    ASSERT_EQ(tree.journal().size(), 2u);
+    ASSERT_EQ(tree.journal()[0].event, Tree::JournalEvent::Moved);
+    ASSERT_EQ(tree.journal()[0].index, child4.objectIndex());
+    ASSERT_EQ(tree.journal()[1].event, Tree::JournalEvent::Reparented);
+}
+
+TEST(Object, ScopeCache)
+{
+    Tree tree;
+    Object root, child1, child2, subchild;
+    tree.setScopeCached(true);
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child1.parent(root, "child1"_hash);
+    child2.parent(root, "child2"_hash);
+    subchild.parent(child1, "subchild"_hash);
+
+    ASSERT_EQ(subchild.find("child2"_hash), &child2);
+    ASSERT_EQ(subchild.find("child2"_hash), &child2);
+    ASSERT_EQ(subchild.find("other"_hash), nullptr);
+    const auto generation = tree.generation();
+    const auto topologyGeneration = tree.topologyGeneration();
+    child2.id("other"_hash);
+    ASSERT_NE(tree.generation(), generation);
+    ASSERT_EQ(tree.topologyGeneration(), topologyGeneration);
+    ASSERT_EQ(subchild.find("child2"_hash), nullptr);
+    ASSERT_EQ(subchild.find("other"_hash), &child2);
+    child2.parent(subchild);
+    ASSERT_EQ(child1.find("other"_hash), nullptr);
+    ASSERT_EQ(subchild.find("other"_hash), &child2);
+}
+
+TEST(Object, FindPath)
+{
+    Tree tree;
+    Object root, panel, button, other;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    panel.parent(root, "panel"_hash);
+    button.parent(panel, "button"_hash);
+    other.parent(root, "button"_hash);
+
+    ASSERT_EQ(root.findPath({ "panel"_hash, "button"_hash }), &button);
+    ASSERT_EQ(root.findPath({ "button"_hash }), &other);
+    ASSERT_EQ(panel.findPath({ "panel"_hash }), nullptr);
+    ASSERT_EQ(tree.findPath(Tree::RootIndex, { "root"_hash, "panel"_hash }), panel.objectIndex());
+
+    ObjectUtils::TreePath path("panel.button");
+    ASSERT_EQ(path.ids().size(), 2u);
+    ASSERT_EQ(root.findPath(path), &button);
+    button.id("renamed"_hash);
+    ASSERT_EQ(root.findPath(path), nullptr);
+    other.parent(panel);
+    ASSERT_EQ(root.findPath(path), &other);
+}
+
+TEST(Object, TransferSubtree)
+{
+    Tree source, destination;
+    Object root1, root2, child, subchild1, subchild2;
+    int parentChangedCount = 0;
+    int subchildParentChangedCount = 0;
+    root1.parent(source, Tree::RootIndex, "root1"_hash);
+    root2.parent(destination, Tree::RootIndex, "root2"_hash);
+    child.parent(root1, "child"_hash);
+    subchild1.parent(child, "subchild1"_hash);
+    subchild2.parent(child, "subchild2"_hash);
+    child.connect<&Object::parentChanged>([&parentChangedCount] { ++parentChangedCount; });
+    subchild1.connect<&Object::parentChanged>([&subchildParentChangedCount] { ++subchildParentChangedCount; });
+
+    child.parent(root2);
+    ASSERT_EQ(parentChangedCount, 1);
+    ASSERT_EQ(subchildParentChangedCount, 0);
+    ASSERT_EQ(root1.childrenCount(), 0u);
+    ASSERT_EQ(root2.childrenCount(), 1u);
+    ASSERT_EQ(child.objectTree(), &destination);
+    ASSERT_EQ(subchild1.objectTree(), &destination);
+    ASSERT_EQ(subchild2.objectTree(), &destination);
+    ASSERT_EQ(child.parent(), &root2);
+    ASSERT_EQ(subchild2.parent(), &child);
+    ASSERT_EQ(child.getChild(0u), &subchild1);
+    ASSERT_EQ(child.getChild(1u), &subchild2);
+    ASSERT_EQ(child.id(), "child"_hash);
+    ASSERT_EQ(root2.findGlobal("subchild2"_hash), &subchild2);
+    ASSERT_EQ(root1.findGlobal("subchild2"_hash), nullptr);
+
+    const auto index = source.transferSubtree(root1.objectIndex(), destination, Tree::RootIndex);
+    ASSERT_EQ(root1.objectIndex(), index);
+    ASSERT_EQ(root1.objectTree(), &destination);
+    ASSERT_EQ(source.get(Tree::RootIndex).children.size(), 0u);
+}
+
+TEST(Object, TreeCapacityHint)
+{
+    // The capacity hint only presizes columns, growing past it reallocates them
+    Tree small(2u);
+    ASSERT_GE(small.capacity(), 2u);
+    ASSERT_EQ(small.nodeCount(), 1u);
+    Object root, child1, child2;
+    root.parent(small, Tree::RootIndex, "root"_hash);
+    child1.parent(root, "child1"_hash);
+    child2.parent(root, "child2"_hash);
+    ASSERT_GE(small.capacity(), 4u);
+    ASSERT_EQ(root.find("child2"_hash), &child2);
+
+    Tree large(100000u);
+    ASSERT_GE(large.capacity(), 100000u);
+    ASSERT_GE(Tree().capacity(), Tree::DefaultTableSize);
+}
+
+TEST(Object, WeakObjectHandle)
+{
+    Tree tree;
+    Object root, child1, child2;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child1.parent(root, "child1"_hash);
+    ASSERT_EQ(Object().weakHandle().get(), nullptr);
+
+    const auto handle = child1.weakHandle();
+    ASSERT_EQ(handle.get(), &child1);
+    const auto index = child1.objectIndex();
+    const auto generation = tree.nodeGeneration(index);
+    child1.removeFromTree();
+    ASSERT_FALSE(handle.isValid());
+    ASSERT_EQ(tree.nodeGeneration(index), generation + 1u);
+    child2.parent(root, "child2"_hash);
+    ASSERT_EQ(child2.objectIndex(), index);
+    ASSERT_EQ(tree.nodeGeneration(index), generation + 2u);
+    ASSERT_EQ(handle.get(), nullptr);
+    ASSERT_EQ(child2.weakHandle().get(), &child2);
+
+    // Slots start live, so handles of a fresh tree resolve
+    Tree fresh;
+    ASSERT_EQ(fresh.resolve(fresh.handle(Tree::RootIndex)), Tree::RootIndex);
+
+    // Compaction only invalidates handles of moved nodes
+    Object child3;
+    child3.parent(root, "child3"_hash);
+    const auto rootHandle = root.weakHandle();
+    const auto child3Handle = child3.weakHandle();
+    const auto child3Index = child3.objectIndex();
+    child2.removeFromTree();
+    static_cast<void>(tree.compact());
+    ASSERT_EQ(rootHandle.get(), &root);
+    ASSERT_NE(child3.objectIndex(), child3Index);
+    ASSERT_EQ(child3Handle.get(), nullptr);
+    ASSERT_EQ(child3.weakHandle().get(), &child3);
+
+    // Slots released by the compaction don't resolve old handles once reused
+    Object child4;
+    child4.parent(root, "child4"_hash);
+    ASSERT_EQ(child4.objectIndex(), child3Index);
+    ASSERT_EQ(child3Handle.get(), nullptr);
+    ASSERT_EQ(child4.weakHandle().get(), &child4);
+}
+
+TEST(Object, Journal)
+{
+    Tree tree;
+    Object root, child1, child2;
+    std::vector<Tree::JournalEvent> events;
+    tree.setJournaled(true);
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child1.parent(root, "child1"_hash);
+    child2.parent(root, "child2"_hash);
+    child2.id("renamed"_hash);
+    child1.visible(false);
+    child2.parent(child1);
+    child1.removeFromTree();
+
+    ASSERT_EQ(tree.journal().size(), 8u);
+    ASSERT_EQ(tree.journal()[6].event, Tree::JournalEvent::Removed);
+    ASSERT_EQ(tree.journal()[6].parentIndex, root.objectIndex());
+    ASSERT_EQ(tree.journal()[7].index, child2.objectIndex());
+    tree.drainJournal([&events](const Tree::JournalEntry &entry) { events.push_back(entry.event); });
+    ASSERT_TRUE(tree.journal().empty());
+    ASSERT_EQ(events, (std::vector<Tree::JournalEvent> {
+        Tree::JournalEvent::Added, Tree::JournalEvent::Added, Tree::JournalEvent::Added, Tree::JournalEvent::IdChanged,
+        Tree::JournalEvent::VisibleChanged, Tree::JournalEvent::Reparented, Tree::JournalEvent::Removed, Tree::JournalEvent::Reparented
+    }));
+
+    tree.setJournaled(false);
+    child1.parent(root);
+    ASSERT_TRUE(tree.journal().empty());
+    // child1 took its freed slot back, child2 stays orphaned
+    ASSERT_EQ(child2.parent(), nullptr);
+    ASSERT_TRUE(tree.get(child1.objectIndex()).children.empty());
+}
+
+TEST(Object, RemoveOrphansChildren)
+{
+    Tree tree;
+    Object root, child, grandChild, other;
+    root.parent(tree, Tree::RootIndex, "root"_hash);
+    child.parent(root, "child"_hash);
+    grandChild.parent(child, "grandChild"_hash);
+    child.removeFromTree();
+
+    // Orphans stay in the tree without any parent, even once their parent's slot is reused
+    ASSERT_TRUE(grandChild.isInTree());
+    ASSERT_EQ(grandChild.parent(), nullptr);
+    other.parent(root, "other"_hash);
+    ASSERT_EQ(grandChild.parent(), nullptr);
+    ASSERT_TRUE(tree.get(other.objectIndex()).children.empty());
+
+    // Orphans can be attached again without duplicating their node
+    const auto nodeCount = tree.nodeCount();
+    grandChild.parent(other);
+    ASSERT_EQ(grandChild.parent(), &other);
+    ASSERT_EQ(tree.nodeCount(), nodeCount);
+    ASSERT_EQ(tree.get(grandChild.objectIndex()).id, "grandChild"_hash);
+    ASSERT_EQ(tree.get(other.objectIndex()).children.size(), 1u);
+}
@@ -5,6 +5,14 @@
 
 #pragma once
 
+#include <bit>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <unordered_map>
+
 #include <Kube/Core/SmallVector.hpp>
 #include <Kube/Core/Vector.hpp>
 #include <Kube/Core/Hash.hpp>
@@ -16,16 +24,22 @@ namespace kF
     namespace ObjectUtils
     {
         class Tree;
+        class TreeSnapshot;
     }
 }
 
-/** @brief A tree of objects which comes in form of a big array for fast search
+/** @brief A tree of objects which comes in form of a structure of arrays for fast search
+ *
+ *  Each node field is stored in its own column, so a pass reading a single field (visibility, flags, ids)
+ *  only streams through that field's memory
  *
  *  This class provides stable indexing (nodes' indexes) but NOT stable addressing (nodes' pointers)
  *  This class is not thread safe at all
 */
 class alignas_cacheline kF::ObjectUtils::Tree
 {
+    friend class TreeSnapshot;
+
 public:
     /** @brief Object flags that can be used to perform */
     enum class Flags : std::uint16_t {
@@ -60,24 +74,151 @@ public:
     /** @brief Number of nodes in the table on startup */
     static constexpr Index DefaultTableSize = 4096u;
 
-    /** @brief Represent an object in a node tree */
-    struct alignas_cacheline Node
+    /** @brief Children indexes of a node
+     *  Compact trees (KUBE_OBJECT_COMPACT_TREE) store every children list out of line,
+     *  so that leaves, which are most of the nodes, only cost the container header */
+#ifdef KUBE_OBJECT_COMPACT_TREE
+    using Children = Core::Vector<Index, Index>;
+    static_assert_fit_quarter_cacheline(Children);
+#else
+    using Children = Core::SmallVector<Index, 24u / sizeof(Index), Index>;
+#endif
+
+    /** @brief Bytes used by a single node across every column, out of line children excluded */
+    static constexpr std::size_t NodeFootprint = sizeof(Object *) + sizeof(HashedName) + sizeof(Index) + sizeof(bool) * 2u
+        + sizeof(Flags) + sizeof(Children) + sizeof(Index) + sizeof(std::uint32_t) + sizeof(std::uint8_t) * 2u;
+#ifdef KUBE_OBJECT_COMPACT_TREE
+    static_assert(NodeFootprint <= Core::CacheLineSize * 3u / 4u, "Compact tree node doesn't fit three quarters of a cacheline");
+#endif
+
+    /** @brief Proxy over a node whose fields are stored in separate columns
+     *  It behaves like the node itself: every member refers to the node's entry of a column */
+    template<bool IsConst>
+    struct BasicNodeRef
     {
-        using Children = Core::SmallVector<Index, 24u / sizeof(Index), Index>;
+        template<typename Type>
+        using Field = std::conditional_t<IsConst, const Type &, Type &>;
+
+        Field<Object *> object;
+        Field<HashedName> id;
+        Field<Index> parentIndex;
+        Field<bool> enabled; // False will prevent propagating event
+        Field<bool> visible; // False will prevent propagating rendering
+        Field<Flags> flags;
+        Field<Children> children;
+    };
+
+    /** @brief Volatile node proxy */
+    using NodeRef = BasicNodeRef<false>;
 
+    /** @brief Constant node proxy */
+    using ConstNodeRef = BasicNodeRef<true>;
+
+    /** @brief Check if a flag set contains every bit of 'flag' */
+    [[nodiscard]] static constexpr bool HasFlag(const Flags flags, const Flags flag) noexcept
+        { return (static_cast<std::uint16_t>(flags) & static_cast<std::uint16_t>(flag)) == static_cast<std::uint16_t>(flag); }
+
+    /** @brief Per-node count of nodes holding an indexed flag in their subtree (node included) */
+    struct FlagIndex
+    {
+        Flags flag { Flags::None };
+        Core::Vector<Index, Index> counts {};
+    };
+
+    /** @brief Description of a node inserted by 'addBatch'
+     *  'parent' is the position of the parent node in the batch (which must come first) or NullIndex to use the batch parent */
+    struct BatchNode
+    {
         Object *object { nullptr };
         HashedName id { 0u };
-        Index parentIndex { NullIndex };
-        bool enabled { true }; // False will prevent propagating event
-        bool visible { true }; // False will prevent propagating rendering
+        Index parent { NullIndex };
         Flags flags { Flags::None };
-        Children children {};
     };
 
-    static_assert_fit_cacheline(Node);
+    /** @brief Weak reference to a node, resolving to NullIndex once the node is removed or its index changes */
+    struct NodeHandle
+    {
+        Index index { NullIndex };
+        std::uint32_t generation { 0u };
+    };
+
+    /** @brief Filter used to prune tree visits
+     *  Members have no default initializer so the filter can be used as a default argument, value-initialize it instead */
+    struct VisitFilter
+    {
+        bool enabledOnly; // Prune disabled subtrees
+        bool visibleOnly; // Prune hidden subtrees
+        Flags flag; // Only visit nodes holding this flag (subtrees without it are pruned if the flag is indexed)
+    };
+
+    /** @brief Kind of change tracked by the dirty system */
+    enum class DirtyType : std::uint8_t {
+        Tree            = 0b1,
+        Enabled         = 0b10,
+        Visible         = 0b100,
+        Flags           = 0b1000
+    };
+
+    /** @brief Kind of mutation recorded by the journal */
+    enum class JournalEvent : std::uint8_t {
+        Added,
+        Removed,
+        Reparented,
+        Moved, // The node changed of position among its siblings, filling the hole of an unstable unlink
+        IdChanged,
+        EnabledChanged,
+        VisibleChanged,
+        FlagsChanged,
+        Compacted, // Every node changed of index, previous entries refer to the old indexes
+        Reset // The whole tree has been replaced by 'deserialize'
+    };
+
+    /** @brief A single mutation of the journal
+     *  'parentIndex' is the new parent of added or reparented nodes, the former parent of removed ones
+     *  and the current parent for every other change (NullIndex for tree-wide events) */
+    struct JournalEntry
+    {
+        JournalEvent event { JournalEvent::Added };
+        Index index { NullIndex };
+        Index parentIndex { NullIndex };
+    };
+
+    /** @brief List of subtree roots that changed since last clear */
+    using DirtyRoots = Core::Vector<Index, Index>;
+
+    /** @brief Header of a serialized tree, followed by the node columns
+     *  Columns are stored in native endianness: ids, parents, type names, children offsets, children indexes,
+     *  free list, flags and states (enabled / visible bits) */
+    struct SerializedHeader
+    {
+        std::uint32_t magic { SerializedMagic };
+        std::uint32_t version { SerializedVersion };
+        Index nodeCount { 0u };
+        Index childCount { 0u };
+        Index freeCount { 0u };
+    };
+
+    /** @brief Magic number and version of the serialized format */
+    static constexpr std::uint32_t SerializedMagic = 0x4B545245u;
+    static constexpr std::uint32_t SerializedVersion = 1u;
+
+    /** @brief Hashed id to node index multimap used to accelerate global lookups */
+    using IdIndex = std::unordered_multimap<HashedName, Index>;
+
+    /** @brief Memoized scoped lookups, keyed by (from, id) and valid for a single generation */
+    struct ScopeCache
+    {
+        std::unordered_map<std::uint64_t, Index> entries {};
+        std::uint64_t generation { 0u };
+    };
 
-    /** @brief Default constructor */
-    Tree(void) noexcept;
+    /** @brief Default constructor, reserving 'DefaultTableSize' nodes */
+    Tree(void) noexcept : Tree(DefaultTableSize) {}
+
+    /** @brief Construct the tree with a capacity hint, reserving every node column to hold at least 'capacityHint' nodes
+     *  This is only a hint: columns stay contiguous vectors that reallocate once it is exceeded
+     *  Node indexes and handles survive reallocations, but references into columns don't */
+    explicit Tree(const Index capacityHint) noexcept;
 
     /** @brief Move constructor */
     Tree(Tree &&other) noexcept = default;
@@ -90,66 +231,474 @@ public:
 
 
     /** @brief Get a node of the tree using its index */
-    [[nodiscard]] Node &get(const Index index) noexcept
-        { return _nodes[index]; }
-    [[nodiscard]] const Node &get(const Index index) const noexcept
-        { return _nodes[index]; }
+    [[nodiscard]] NodeRef get(const Index index) noexcept
+        { return NodeRef { _objects[index], _ids[index], _parents[index], _enabled[index], _visible[index], _flags[index], _children[index] }; }
+    [[nodiscard]] ConstNodeRef get(const Index index) const noexcept
+        { return ConstNodeRef { _objects[index], _ids[index], _parents[index], _enabled[index], _visible[index], _flags[index], _children[index] }; }
+
+    /** @brief Get the number of nodes in the tree, including the root and free slots */
+    [[nodiscard]] Index nodeCount(void) const noexcept { return _ids.size(); }
+
+    /** @brief Get the generation of a node slot, incremented each time the slot is released or reused
+     *  Live slots hold odd generations and free slots even ones
+     *  The column may outlive the node count after 'compact' or 'deserialize' so that released slots never reuse a generation */
+    [[nodiscard]] std::uint32_t nodeGeneration(const Index index) const noexcept { return _nodeGenerations[index]; }
+
+    /** @brief Get a weak handle over a node */
+    [[nodiscard]] NodeHandle handle(const Index index) const noexcept
+        { return NodeHandle { index: index, generation: _nodeGenerations[index] }; }
+
+    /** @brief Resolve a weak handle in O(1), returns NullIndex if its node has been removed, moved by 'compact' or replaced by 'deserialize' */
+    [[nodiscard]] Index resolve(const NodeHandle handle) const noexcept;
+
+    /** @brief Get the number of nodes the tree can hold before reallocating its columns */
+    [[nodiscard]] Index capacity(void) const noexcept { return _ids.capacity(); }
+
+    /** @brief Get the structure generation, incremented each time a node is added, removed, reparented or renamed */
+    [[nodiscard]] std::uint64_t generation(void) const noexcept { return _generation; }
+
+    /** @brief Get the id generation, incremented each time a node is renamed */
+    [[nodiscard]] std::uint64_t idGeneration(void) const noexcept { return _idGeneration; }
+
+    /** @brief Get the topology generation, incremented each time a node is added, removed or reparented (renames excluded) */
+    [[nodiscard]] std::uint64_t topologyGeneration(void) const noexcept { return _generation - _idGeneration; }
 
+    /** @brief Get the state generation, incremented each time a node's flags, enabled or visible state changes */
+    [[nodiscard]] std::uint64_t stateGeneration(void) const noexcept { return _stateGeneration; }
+
+    /** @brief Get the enabled generation, incremented each time a node's enabled state changes */
+    [[nodiscard]] std::uint64_t enabledGeneration(void) const noexcept { return _enabledGeneration; }
+
+    /** @brief Get the flags generation, incremented each time a node's flags change */
+    [[nodiscard]] std::uint64_t flagsGeneration(void) const noexcept { return _flagsGeneration; }
+
+
+    /** @brief Column getters, each column is indexed by node index (free slots included) */
+    [[nodiscard]] const Core::Vector<Object *, Index> &objects(void) const noexcept { return _objects; }
+    [[nodiscard]] const Core::Vector<HashedName, Index> &ids(void) const noexcept { return _ids; }
+    [[nodiscard]] const Core::Vector<Index, Index> &parents(void) const noexcept { return _parents; }
+    [[nodiscard]] const Core::Vector<bool, Index> &enabledStates(void) const noexcept { return _enabled; }
+    [[nodiscard]] const Core::Vector<bool, Index> &visibleStates(void) const noexcept { return _visible; }
+    [[nodiscard]] const Core::Vector<Flags, Index> &flags(void) const noexcept { return _flags; }
+    [[nodiscard]] const Core::Vector<Children, Index> &children(void) const noexcept { return _children; }
+
+    /** @brief Get the position of a node in its parent's children (NullIndex if it has no parent) */
+    [[nodiscard]] Index childPosition(const Index index) const noexcept { return _childPositions[index]; }
+
+
+    /** @brief Reserve every node column to hold at least 'capacityHint' nodes */
+    void reserve(const Index capacityHint) noexcept;
 
     /** @brief Adds a node into the tree */
     [[nodiscard]] Index add(const Index parentIndex, Object * const object, const HashedName id, const Flags flags) noexcept;
 
-    /** @brief Removes a node from the tree */
+    /** @brief Adds a whole array of nodes in a single pass, below 'parentIndex'
+     *  Nodes are appended contiguously (free slots are not reused) and dirty states are only marked once
+     *  Returns the index of each inserted node */
+    [[nodiscard]] Core::Vector<Index, Index> addBatch(const Index parentIndex, const BatchNode * const begin, const BatchNode * const end) noexcept_ndebug;
+
+    /** @brief Removes a node from the tree
+     *  Children of the node are orphaned (their parent index becomes NullIndex, in their object cache too) */
     void remove(const Index index) noexcept;
 
+    /** @brief Removes a node and all its descendants from the tree in a single pass
+     *  Object caches of every removed node are detached from the tree, the root can't be removed */
+    void removeSubtree(const Index index) noexcept_ndebug;
+
+    /** @brief Removes every descendant of a node from the tree in a single pass
+     *  Object caches of every removed node are detached from the tree */
+    void removeChildren(const Index index) noexcept;
+
+
+    /** @brief Move a node and all its descendants below 'parentIndex' of another tree, in a single pass
+     *  Nodes keep their ids, flags, states and children order, and are appended contiguously to 'destination'
+     *  Object caches of every moved node are rebound to 'destination', no callback nor signal is emitted
+     *  The root node can't be transferred
+     *  Returns the index of the moved node in 'destination' */
+    Index transferSubtree(const Index index, Tree &destination, const Index parentIndex) noexcept_ndebug;
+
 
     /** @brief Replace index of a node for another existing one */
     void setParent(const Index index, const Index parentIndex) noexcept;
 
+    /** @brief Set the hashed name of a node (keeps the id index up to date) */
+    void setId(const Index index, const HashedName id) noexcept;
+
+    /** @brief Set the flags of a node (keeps flag indexes up to date), marking the node flags-dirty on change */
+    void setFlags(const Index index, const Flags flags) noexcept;
+
+
+    /** @brief Check if unlinking a child preserves the order of its siblings (true by default) */
+    [[nodiscard]] bool isChildOrderStable(void) const noexcept { return _childOrderStable; }
+
+    /** @brief Choose how a child is unlinked from its parent on removal or reparenting
+     *  A stable order shifts the following siblings, an unstable one moves the last sibling in place of the child in O(1)
+     *  Wide containers that don't rely on their children order should disable it */
+    void setChildOrderStable(const bool value) noexcept;
+
+
+    /** @brief Renumber every node in pre-order depth-first order and release free slots
+     *  Object caches are patched through the nodes' object pointer
+     *  Orphan branches (nodes whose parent has been removed) are appended after the root's hierarchy
+     *  Handles of nodes that kept their index stay valid, handles of moved nodes are invalidated
+     *  Returns a table mapping each old index to its new index (NullIndex for released slots) */
+    [[nodiscard]] Core::Vector<Index, Index> compact(void) noexcept;
+
+
+    /** @brief Get the size in bytes of the serialized tree */
+    [[nodiscard]] std::size_t serializedSize(void) const noexcept;
+
+    /** @brief Serialize topology, ids, flags, enabled / visible states and object type names into 'buffer'
+     *  The buffer must be 4 bytes aligned and hold at least 'serializedSize()' bytes */
+    void serialize(void * const buffer) const noexcept;
+
+    /** @brief Replace the whole tree by a serialized one, which can be directly read from a memory mapped file
+     *  Each column is filled with a single bulk copy, objects pointers are null until bound with 'bindObject'
+     *  Objects bound to the replaced tree are detached (as if removed) without any callback
+     *  Indexes enabled on this tree are rebuilt and every node is marked dirty, every handle is invalidated
+     *  Returns false (leaving the tree untouched) if the data is invalid */
+    [[nodiscard]] bool deserialize(const void * const data, const std::size_t size) noexcept;
+
+    /** @brief Get the object type name column of valid serialized data (0 for nodes without object) */
+    [[nodiscard]] static const HashedName *SerializedTypeNames(const void * const data) noexcept;
+
+    /** @brief Bind an object to an existing node, updating the object's cache */
+    void bindObject(const Index index, Object * const object) noexcept;
+
+
+    /** @brief Check if the tree maintains an id index */
+    [[nodiscard]] bool isIdIndexed(void) const noexcept { return _idIndex.operator bool(); }
+
+    /** @brief Enable or disable the id index
+     *  When enabled, 'find' runs in O(1) average instead of scanning every node
+     *  Enabling the index on a populated tree will index every existing node */
+    void setIdIndexed(const bool value) noexcept;
+
+
+    /** @brief Check if the tree maintains an index for a single flag */
+    [[nodiscard]] bool isFlagIndexed(const Flags flag) const noexcept { return findFlagIndex(flag) != nullptr; }
+
+    /** @brief Enable or disable the index of a single flag
+     *  An indexed flag lets 'forEachFlagged' skip every subtree that doesn't contain the flag */
+    void setFlagIndexed(const Flags flag, const bool value) noexcept;
+
+    /** @brief Get the per-node counts of an indexed flag (see 'FlagIndex'), or null if the flag isn't indexed */
+    [[nodiscard]] const Core::Vector<Index, Index> *flagCounts(const Flags flag) const noexcept;
+
+    /** @brief Get the number of nodes holding an indexed flag in the hierarchy of 'from' (node included) */
+    [[nodiscard]] Index flaggedCount(const Flags flag, const Index from = RootIndex) const noexcept;
+
+    /** @brief Call 'functor(index)' on every node of 'from' hierarchy holding 'flag', in pre-order (tree order)
+     *  If the flag is indexed, subtrees without any matching node are skipped, else every node is visited */
+    template<typename Functor>
+    void forEachFlagged(const Flags flag, Functor &&functor, const Index from = RootIndex) const
+        noexcept(std::is_nothrow_invocable_v<Functor, Index>);
+
+
+    /** @brief Visit 'root' hierarchy in parallel, calling 'functor(index)' on every node passing 'filter' (defined in TreeParallel.hpp)
+     *  The hierarchy is split into subtree tasks shared by 'threadCount' threads of the persistent 'TreeWorkerPool'
+     *  (every thread of the pool if null), an idle thread steals the remaining tasks of the others
+     *  If 'functor' throws, remaining tasks are dropped and the first exception is rethrown once every thread stopped
+     *  If 'functor' returns a boolean, false prevents visiting the node's children
+     *  The tree must not be modified during the visit and 'functor' must be thread safe */
+    template<typename Functor>
+    void parallelVisit(const Index root, Functor &&functor,
+            const VisitFilter filter = VisitFilter {}, const std::uint32_t threadCount = 0u) const;
+
+    /** @brief Collect in parallel every node of 'root' hierarchy passing 'filter' and 'predicate(index)' (defined in TreeParallel.hpp)
+     *  Per-thread results are merged in pre-order (tree order), so the result doesn't depend on scheduling
+     *  The tree must not be modified during the visit and 'predicate' must be thread safe */
+    template<typename Predicate>
+    [[nodiscard]] Core::Vector<Index, Index> parallelCollect(const Index root, Predicate &&predicate,
+            const VisitFilter filter = VisitFilter {}, const std::uint32_t threadCount = 0u) const;
+
 
     /** @brief Find a node using its hashed name
-     *  Be aware that id can collide and thus, the function will return the first match */
+     *  Be aware that id can collide and thus, the function will return the first match (lowest index) */
     [[nodiscard]] Index find(const HashedName id) const noexcept;
 
+    /** @brief Find a node using its hashed name by scanning every node, even if the tree is indexed
+     *  Be aware that id can collide and thus, the function will return the first match */
+    [[nodiscard]] Index findLinear(const HashedName id) const noexcept;
+
     /** @brief Find a node using its hashed name and a starting point
      *  This function will search in 'from' close children then in every parent and their close children
      *  This mean you can't access a sub-child or the sub-child of a parent
-     *  Be aware that id can collide and thus, the function will return the first match */
+     *  Be aware that id can collide and thus, the function will return the first match
+     *  If the scope cache is enabled, the result is memoized until the tree generation changes */
     [[nodiscard]] Index findInScope(const HashedName id, const Index from) const noexcept;
 
+    /** @brief Find a descendant of 'from' by following a path of hashed names, one children level per name
+     *  Each level is resolved through its node's children only, and the first matching child is taken
+     *  Returns NullIndex if a level doesn't match, an empty path returns 'from' */
+    [[nodiscard]] Index findPath(const Index from, const HashedName * const begin, const HashedName * const end) const noexcept;
+    [[nodiscard]] Index findPath(const Index from, const std::initializer_list<HashedName> path) const noexcept
+        { return findPath(from, path.begin(), path.end()); }
+
+    /** @brief Find a node using its hashed name and a starting point, without using the scope cache */
+    [[nodiscard]] Index findInScopeLinear(const HashedName id, const Index from) const noexcept;
+
+
+    /** @brief Check if the tree memoizes scoped lookups */
+    [[nodiscard]] bool isScopeCached(void) const noexcept { return _scopeCache.operator bool(); }
+
+    /** @brief Enable or disable the scope cache
+     *  When enabled, repeated 'findInScope' calls on the same (from, id) pair run in O(1) average until the structure changes
+     *  Note that 'findInScope' then writes into the cache and must not be called concurrently */
+    void setScopeCached(const bool value) noexcept;
+
+
+    /** @brief Set the enabled state of a node, marking its subtree enabled-dirty on change */
+    void setEnabled(const Index index, const bool state) noexcept;
+
+    /** @brief Set the visible state of a node, marking its subtree visible-dirty on change */
+    void setVisible(const Index index, const bool state) noexcept;
+
+
+    /** @brief Get the effective enabled state of a node (false if the node or one of its ancestors is disabled)
+     *  Effective states are lazily recomputed, only in subtrees that changed since last query */
+    [[nodiscard]] bool effectivelyEnabled(const Index index) noexcept;
+
+    /** @brief Get the effective visible state of a node (false if the node or one of its ancestors is hidden)
+     *  Effective states are lazily recomputed, only in subtrees that changed since last query */
+    [[nodiscard]] bool effectivelyVisible(const Index index) noexcept;
+
+    /** @brief Check if some effective states are waiting to be recomputed */
+    [[nodiscard]] bool isEffectiveStateDirty(void) const noexcept { return !_effectiveDirtyRoots.empty(); }
+
+    /** @brief Recompute effective states of every subtree that changed */
+    void updateEffectiveStates(void) noexcept;
+
+
+    /** @brief Mark a subtree as dirty for a given kind of change
+     *  Nothing is recorded if the node or one of its ancestors is already dirty for that kind
+     *  Note that a recorded root may still be contained in a root recorded later */
+    void markDirty(const Index index, const DirtyType type) noexcept;
+
+    /** @brief Clear every dirty subtree root of a given kind of change */
+    void clearDirty(const DirtyType type) noexcept;
+
+    /** @brief Get the subtree roots that changed for a given kind of change */
+    [[nodiscard]] const DirtyRoots &dirtyRoots(const DirtyType type) const noexcept
+        { return _dirtyRoots[DirtyTypeIndex(type)]; }
+
+
+    /** @brief Check if the tree records its mutations into the journal */
+    [[nodiscard]] bool isJournaled(void) const noexcept { return _journaled; }
+
+    /** @brief Enable or disable the mutation journal (disabling it clears every entry) */
+    void setJournaled(const bool value) noexcept;
+
+    /** @brief Get the mutations recorded since the journal was last drained, in order */
+    [[nodiscard]] const Core::Vector<JournalEntry, std::uint32_t> &journal(void) const noexcept { return _journal; }
+
+    /** @brief Get the sequence number of the first journal entry, entries being numbered since the tree construction
+     *  Drained entries keep their numbers and enabling the journal skips one, so that a reader can tell
+     *  whether the journal still holds every mutation since a given sequence number */
+    [[nodiscard]] std::uint64_t journalSequence(void) const noexcept { return _journalSequence; }
+
+    /** @brief Call 'functor(entry)' on every recorded mutation in order, then clear the journal */
+    template<typename Functor>
+    void drainJournal(Functor &&functor) noexcept(std::is_nothrow_invocable_v<Functor, const JournalEntry &>);
+
 
     /** @brief Check if the tree has changed */
-    [[nodiscard]] bool isTreeDirty(void) const noexcept { return _treeDirty; }
+    [[nodiscard]] bool isTreeDirty(void) const noexcept { return !dirtyRoots(DirtyType::Tree).empty(); }
 
-    /** @brief Set the tree dirty flag */
-    void setTreeDirtyFlag(const bool value) noexcept { _treeDirty = value; }
+    /** @brief Set the tree dirty flag (true marks the whole tree, false clears every structure change) */
+    void setTreeDirtyFlag(const bool value) noexcept { setDirtyFlag(DirtyType::Tree, value); }
+
+    /** @brief Get the subtree roots whose structure changed */
+    [[nodiscard]] const DirtyRoots &treeDirtyRoots(void) const noexcept { return dirtyRoots(DirtyType::Tree); }
 
 
     /** @brief Check if the tree event-ability has changed */
-    [[nodiscard]] bool isEnabledDirty(void) const noexcept { return _enabledDirty; }
+    [[nodiscard]] bool isEnabledDirty(void) const noexcept { return !dirtyRoots(DirtyType::Enabled).empty(); }
+
+    /** @brief Set the tree event-ability dirty flag (true marks the whole tree, false clears every event-ability change) */
+    void setEnabledDirtyFlag(const bool value) noexcept { setDirtyFlag(DirtyType::Enabled, value); }
 
-    /** @brief Set the tree event-ability dirty flag */
-    void setEnabledDirtyFlag(const bool value) noexcept { _enabledDirty = value; }
+    /** @brief Get the subtree roots whose event-ability changed */
+    [[nodiscard]] const DirtyRoots &enabledDirtyRoots(void) const noexcept { return dirtyRoots(DirtyType::Enabled); }
 
 
     /** @brief Check if the tree visibility has changed */
-    [[nodiscard]] bool isVisibleDirty(void) const noexcept { return _visibleDirty; }
+    [[nodiscard]] bool isVisibleDirty(void) const noexcept { return !dirtyRoots(DirtyType::Visible).empty(); }
 
-    /** @brief Set the tree event-ability dirty flag */
-    void setVisibleDirtyFlag(const bool value) noexcept { _visibleDirty = value; }
+    /** @brief Set the tree visibility dirty flag (true marks the whole tree, false clears every visibility change) */
+    void setVisibleDirtyFlag(const bool value) noexcept { setDirtyFlag(DirtyType::Visible, value); }
+
+    /** @brief Get the subtree roots whose visibility changed */
+    [[nodiscard]] const DirtyRoots &visibleDirtyRoots(void) const noexcept { return dirtyRoots(DirtyType::Visible); }
+
+
+    /** @brief Check if the flags of some nodes have changed */
+    [[nodiscard]] bool isFlagsDirty(void) const noexcept { return !dirtyRoots(DirtyType::Flags).empty(); }
+
+    /** @brief Get the subtree roots whose flags changed */
+    [[nodiscard]] const DirtyRoots &flagsDirtyRoots(void) const noexcept { return dirtyRoots(DirtyType::Flags); }
 
 private:
-    Core::Vector<Node, Index> _nodes {};
+    Core::Vector<Object *, Index> _objects {};
+    Core::Vector<HashedName, Index> _ids {};
+    Core::Vector<Index, Index> _parents {};
+    Core::Vector<bool, Index> _enabled {};
+    Core::Vector<bool, Index> _visible {};
+    Core::Vector<Flags, Index> _flags {};
+    Core::Vector<Children, Index> _children {};
+    Core::Vector<Index, Index> _childPositions {};
+    Core::Vector<std::uint32_t, Index> _nodeGenerations {};
+    Core::Vector<std::uint8_t, Index> _effectiveStates {};
+    Core::Vector<std::uint8_t, Index> _dirtyStates {};
     Core::Vector<Index, Index> _freeList {};
-    bool _treeDirty { false };
-    bool _enabledDirty { false };
-    bool _visibleDirty { false };
-    std::byte _padding {};
+    DirtyRoots _dirtyRoots[4] {};
+    DirtyRoots _effectiveDirtyRoots {};
+    Core::Vector<FlagIndex, std::uint32_t> _flagIndexes {};
+    std::unique_ptr<IdIndex> _idIndex {};
+    std::unique_ptr<ScopeCache> _scopeCache {};
+    std::uint64_t _generation { 0u };
+    std::uint64_t _stateGeneration { 0u };
+    std::uint64_t _enabledGeneration { 0u };
+    std::uint64_t _flagsGeneration { 0u };
+    std::uint64_t _idGeneration { 0u };
+    std::uint64_t _journalSequence { 0u };
+    Core::Vector<JournalEntry, std::uint32_t> _journal {};
+    bool _journaled { false };
+    bool _childOrderStable { true };
+
+    /** @brief Effective state bits */
+    static constexpr std::uint8_t EffectiveEnabledBit = 0b1;
+    static constexpr std::uint8_t EffectiveVisibleBit = 0b10;
+
+    /** @brief Dirty state bit of subtrees waiting for effective states recomputation */
+    static constexpr std::uint8_t EffectiveDirtyBit = 0b10000000;
+
+    /** @brief Get the position of a dirty type in the dirty roots table */
+    [[nodiscard]] static constexpr std::size_t DirtyTypeIndex(const DirtyType type) noexcept
+        { return static_cast<std::size_t>(std::countr_zero(static_cast<std::uint8_t>(type))); }
+
+    /** @brief Record a dirty subtree root unless the node or one of its ancestors already holds 'mask' */
+    void markDirtyRoot(const Index index, const std::uint8_t mask, DirtyRoots &roots) noexcept;
+
+    /** @brief Mark a subtree as dirty for every kind of change */
+    void markAllDirty(const Index index) noexcept;
+
+    /** @brief Implementation of the legacy dirty flag setters */
+    void setDirtyFlag(const DirtyType type, const bool value) noexcept;
+
+    /** @brief Forget about a node in every dirty roots list */
+    void eraseDirtyStates(const Index index) noexcept;
+
+    /** @brief Insert a node into the id index (if any) */
+    void insertIdIndex(const Index index, const HashedName id) noexcept;
+
+    /** @brief Remove a node from the id index (if any) */
+    void eraseIdIndex(const Index index, const HashedName id) noexcept;
+
+    /** @brief Find the index of a single flag, if any */
+    [[nodiscard]] FlagIndex *findFlagIndex(const Flags flag) noexcept
+        { return const_cast<FlagIndex *>(std::as_const(*this).findFlagIndex(flag)); }
+    [[nodiscard]] const FlagIndex *findFlagIndex(const Flags flag) const noexcept;
+
+    /** @brief Add 'count' to the flag count of 'index' and each of its ancestors */
+    void addFlagCount(FlagIndex &flagIndex, const Index index, const Index count) noexcept;
+
+    /** @brief Remove 'count' from the flag count of 'index' and each of its ancestors */
+    void removeFlagCount(FlagIndex &flagIndex, const Index index, const Index count) noexcept;
+
+    /** @brief Number of tasks per thread a parallel visit tries to create */
+    static constexpr std::uint32_t VisitTasksPerThread = 8u;
+
+    /** @brief Maximum number of refinement passes used to split a parallel visit */
+    static constexpr std::uint32_t VisitMaxRefinePasses = 8u;
+
+    /** @brief Part of a split parallel visit (in pre-order)
+     *  An expanded item only visits its node (its children have their own items), else it visits its whole subtree */
+    struct VisitItem
+    {
+        Index index { NullIndex };
+        std::uint32_t depth { 0u };
+        bool expanded { false };
+    };
+
+    /** @brief Check if a node and its subtree are pruned by a visit filter */
+    [[nodiscard]] bool isVisitPruned(const Index index, const VisitFilter &filter, const FlagIndex * const flagIndex) const noexcept;
+
+    /** @brief Split a visit of 'root' hierarchy into pre-ordered items, each result slot matches an item */
+    [[nodiscard]] Core::Vector<VisitItem, std::uint32_t> splitParallelVisit(const Index root, const VisitFilter &filter,
+            const FlagIndex * const flagIndex, const std::uint32_t threadCount) const noexcept;
+
+    /** @brief Run a split visit, 'visitor(index, slot)' returns false to prune the node's children */
+    template<typename Visitor>
+    void runParallelVisit(const Core::Vector<VisitItem, std::uint32_t> &items, Visitor &visitor,
+            const VisitFilter &filter, const FlagIndex * const flagIndex, const std::uint32_t threadCount) const;
+
+    /** @brief Visit a whole subtree on the calling thread */
+    template<typename Visitor>
+    void visitSubtree(const Index root, const std::uint32_t slot, Visitor &visitor,
+            const VisitFilter &filter, const FlagIndex * const flagIndex, Core::Vector<Index, Index> &stack) const;
+
+    /** @brief Get the thread count of the worker pool if 'threadCount' is null */
+    [[nodiscard]] static std::uint32_t GetVisitThreadCount(const std::uint32_t threadCount);
+
+    /** @brief Collect every used node in pre-order, the root hierarchy first then each orphan branch */
+    void collectPreOrder(Core::Vector<Index, Index> &order) const noexcept;
+
+    /** @brief Byte offsets of each column in serialized data */
+    struct SerializedLayout
+    {
+        std::size_t ids;
+        std::size_t parents;
+        std::size_t typeNames;
+        std::size_t childOffsets;
+        std::size_t childIndexes;
+        std::size_t freeList;
+        std::size_t flags;
+        std::size_t states;
+        std::size_t size;
+    };
+
+    /** @brief Serialized state bits */
+    static constexpr std::uint8_t SerializedEnabledBit = 0b1;
+    static constexpr std::uint8_t SerializedVisibleBit = 0b10;
+
+    /** @brief Compute the layout of serialized data */
+    [[nodiscard]] static SerializedLayout GetSerializedLayout(const Index nodeCount, const Index childCount, const Index freeCount) noexcept;
+
+    /** @brief Check that serialized data describes a valid tree
+     *  Every index must be in range, the root must not have a parent, parents and children lists must match,
+     *  free slots must be detached and nodes must not form a cycle */
+    [[nodiscard]] static bool IsSerializedValid(const std::byte * const data, const std::size_t size) noexcept;
+
+    /** @brief Get the meta type name of an object (defined in Object.ipp) */
+    [[nodiscard]] static HashedName GetObjectTypeName(const Object * const object) noexcept;
+
+    /** @brief Update the tree location stored in an object's cache (defined in Object.ipp) */
+    static void UpdateObjectCache(Object * const object, Tree * const tree, const Index index, const Index parentIndex) noexcept;
+
+    /** @brief Record a mutation if the journal is enabled */
+    void record(const JournalEvent event, const Index index, const Index parentIndex) noexcept;
+
+    /** @brief Append a node to its parent's children */
+    void linkChild(const Index parentIndex, const Index index) noexcept;
+
+    /** @brief Remove a node from its parent's children using its stored position */
+    void unlinkChild(const Index parentIndex, const Index index) noexcept;
+
+    /** @brief Release a node and all its descendants without unlinking it from its parent */
+    void releaseBranch(const Index index, Core::Vector<Index, Index> &stack) noexcept;
 
-    /** @brief Set every dirty flags to true */
-    void setAllDirtyFlags(void) noexcept;
+    /** @brief Append a node at the end of every column */
+    void pushNode(Object * const object, const HashedName id, const Index parentIndex, const Flags flags) noexcept;
 };
 
-static_assert_fit_cacheline(kF::ObjectUtils::Tree);
+// Every node field lives out of line in a column, the tree itself only holds container headers and counters:
+// 12 node columns, 5 dirty root lists, the flag indexes and the journal (19 vector headers),
+// the id index and scope cache pointers, 5 generation counters, the journal sequence and 2 booleans, rounded up to whole cachelines
+// Inline storage in the tree would make its size grow with its content and slow down moving it
+static_assert(sizeof(kF::ObjectUtils::Tree) <= (19u * sizeof(kF::Core::Vector<kF::ObjectUtils::Tree::Index, kF::ObjectUtils::Tree::Index>)
+        + 2u * sizeof(void *) + 6u * sizeof(std::uint64_t) + 2u * sizeof(bool) + kF::Core::CacheLineSize - 1u)
+        / kF::Core::CacheLineSize * kF::Core::CacheLineSize,
+    "Tree holds more than its column headers and counters");
 
 #include "Tree.ipp"
\ No newline at end of file
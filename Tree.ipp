@@ -3,109 +3,1100 @@
  * @ Description: A tree of objects
  */
 
-inline kF::ObjectUtils::Tree::Tree(void) noexcept
+inline kF::ObjectUtils::Tree::Tree(const Index capacityHint) noexcept
 {
-    _nodes.reserve(DefaultTableSize);
-    _nodes.push(Node {});
+    reserve(capacityHint);
+    pushNode(nullptr, 0u, NullIndex, Flags::None);
+}
+
+inline void kF::ObjectUtils::Tree::reserve(const Index capacityHint) noexcept
+{
+    _objects.reserve(capacityHint);
+    _ids.reserve(capacityHint);
+    _parents.reserve(capacityHint);
+    _enabled.reserve(capacityHint);
+    _visible.reserve(capacityHint);
+    _flags.reserve(capacityHint);
+    _children.reserve(capacityHint);
+    _childPositions.reserve(capacityHint);
+    _nodeGenerations.reserve(capacityHint);
+    _effectiveStates.reserve(capacityHint);
+    _dirtyStates.reserve(capacityHint);
+    for (auto &flagIndex : _flagIndexes)
+        flagIndex.counts.reserve(capacityHint);
 }
 
 inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::add(const Index parentIndex, Object * const object, const HashedName id, const Flags flags) noexcept
 {
-    auto &parent = get(parentIndex);
     Index index;
 
-    setAllDirtyFlags();
+    ++_generation;
     if (!_freeList.empty()) {
         index = _freeList.back();
         _freeList.pop();
-        get(index) = Node {
-            object: object,
-            id: id,
-            parentIndex: parentIndex,
-            flags: flags
-        };
+        // Reusing the slot makes its generation live again
+        ++_nodeGenerations[index];
+        _objects[index] = object;
+        _ids[index] = id;
+        _parents[index] = parentIndex;
+        _enabled[index] = true;
+        _visible[index] = true;
+        _flags[index] = flags;
     } else {
-        index = _nodes.size();
-        _nodes.push(Node {
-            object: object,
-            id: id,
-            parentIndex: parentIndex,
-            flags: flags
-        });
-    }
-    parent.children.push(index);
+        index = nodeCount();
+        pushNode(object, id, parentIndex, flags);
+    }
+    // Parent is fetched after insertion as the children column may have been reallocated
+    linkChild(parentIndex, index);
+    record(JournalEvent::Added, index, parentIndex);
+    insertIdIndex(index, id);
+    for (auto &flagIndex : _flagIndexes) {
+        if (HasFlag(flags, flagIndex.flag)) [[unlikely]]
+            addFlagCount(flagIndex, index, 1u);
+    }
+    markAllDirty(parentIndex);
+    markDirtyRoot(index, EffectiveDirtyBit, _effectiveDirtyRoots);
     return index;
 }
 
+inline kF::Core::Vector<kF::ObjectUtils::Tree::Index, kF::ObjectUtils::Tree::Index> kF::ObjectUtils::Tree::addBatch(
+        const Index parentIndex, const BatchNode * const begin, const BatchNode * const end) noexcept_ndebug
+{
+    const auto count = static_cast<Index>(std::distance(begin, end));
+    Core::Vector<Index, Index> indexes;
+
+    indexes.reserve(count);
+    reserve(nodeCount() + count);
+    ++_generation;
+    for (auto it = begin; it != end; ++it) {
+        kFAssert(it->parent == NullIndex || it->parent < indexes.size(),
+            throw std::logic_error("Tree::addBatch: A batch node must come after its parent"));
+        const auto index = nodeCount();
+        const auto nodeParent = it->parent == NullIndex ? parentIndex : indexes[it->parent];
+        pushNode(it->object, it->id, nodeParent, it->flags);
+        linkChild(nodeParent, index);
+        record(JournalEvent::Added, index, nodeParent);
+        insertIdIndex(index, it->id);
+        // Effective states of batch roots are recomputed along with their subtree
+        if (it->parent == NullIndex)
+            markDirtyRoot(index, EffectiveDirtyBit, _effectiveDirtyRoots);
+        indexes.push(index);
+    }
+    // Accumulate flag counts from the last node to the first one (children come after their parent)
+    // so that the ancestors of the batch are only walked once per indexed flag
+    for (auto &flagIndex : _flagIndexes) {
+        Index total = 0u;
+        for (auto i = count; i != 0u;) {
+            --i;
+            const auto index = indexes[i];
+            if (HasFlag(begin[i].flags, flagIndex.flag))
+                ++flagIndex.counts[index];
+            if (begin[i].parent != NullIndex)
+                flagIndex.counts[indexes[begin[i].parent]] += flagIndex.counts[index];
+            else
+                total += flagIndex.counts[index];
+        }
+        if (total) [[unlikely]]
+            addFlagCount(flagIndex, parentIndex, total);
+    }
+    markAllDirty(parentIndex);
+    return indexes;
+}
+
 inline void kF::ObjectUtils::Tree::remove(const Index index) noexcept
 {
-    auto &node = get(index);
+    auto node = get(index);
 
-    setAllDirtyFlags();
     _freeList.push(index);
+    ++_nodeGenerations[index];
+    record(JournalEvent::Removed, index, node.parentIndex);
+    eraseIdIndex(index, node.id);
+    eraseDirtyStates(index);
+    // The node's subtree is discounted from its ancestors, its children keep their own counts
+    for (auto &flagIndex : _flagIndexes) {
+        if (const auto count = flagIndex.counts[index]; count) [[unlikely]]
+            removeFlagCount(flagIndex, index, count);
+    }
     if (node.parentIndex != NullIndex) [[likely]] {
-        auto &parent = get(node.parentIndex);
-        parent.children.erase(std::find(parent.children.begin(), parent.children.end(), index));
+        unlinkChild(node.parentIndex, index);
+        markAllDirty(node.parentIndex);
+    }
+    for (const auto childIndex : node.children) {
+        _parents[childIndex] = NullIndex;
+        _childPositions[childIndex] = NullIndex;
+        if (const auto object = _objects[childIndex]; object) [[likely]]
+            UpdateObjectCache(object, this, childIndex, NullIndex);
+        record(JournalEvent::Reparented, childIndex, NullIndex);
+        markDirtyRoot(childIndex, EffectiveDirtyBit, _effectiveDirtyRoots);
+    }
+    // Reset the free slot so it can't be matched by any lookup
+    node.object = nullptr;
+    node.id = 0u;
+    node.parentIndex = NullIndex;
+    node.children.clear();
+    ++_generation;
+}
+
+inline void kF::ObjectUtils::Tree::removeSubtree(const Index index) noexcept_ndebug
+{
+    kFAssert(index != RootIndex,
+        throw std::logic_error("Tree::removeSubtree: The root node can't be removed, use 'removeChildren' instead"));
+    const auto parentIndex = _parents[index];
+    Core::Vector<Index, Index> stack;
+
+    if (parentIndex != NullIndex) [[likely]] {
+        unlinkChild(parentIndex, index);
+        for (auto &flagIndex : _flagIndexes) {
+            if (const auto count = flagIndex.counts[index]; count) [[unlikely]]
+                removeFlagCount(flagIndex, parentIndex, count);
+        }
+        markAllDirty(parentIndex);
+    }
+    releaseBranch(index, stack);
+    ++_generation;
+}
+
+inline void kF::ObjectUtils::Tree::removeChildren(const Index index) noexcept
+{
+    auto &children = _children[index];
+    Core::Vector<Index, Index> stack;
+
+    if (children.empty()) [[unlikely]]
+        return;
+    for (auto &flagIndex : _flagIndexes) {
+        Index count = 0u;
+        for (const auto childIndex : children)
+            count += flagIndex.counts[childIndex];
+        if (count) [[unlikely]]
+            removeFlagCount(flagIndex, index, count);
+    }
+    for (const auto childIndex : children)
+        releaseBranch(childIndex, stack);
+    children.clear();
+    markAllDirty(index);
+    ++_generation;
+}
+
+inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::transferSubtree(const Index index, Tree &destination, const Index parentIndex) noexcept_ndebug
+{
+    kFAssert(&destination != this,
+        throw std::logic_error("Tree::transferSubtree: Use 'setParent' to move a subtree within its tree"));
+    kFAssert(index != RootIndex,
+        throw std::logic_error("Tree::transferSubtree: The root node can't be transferred"));
+    const auto sourceParent = _parents[index];
+    const auto first = destination.nodeCount();
+    Core::Vector<std::pair<Index, Index>, Index> stack;
+
+    // Append the branch in pre-order, children are pushed in reverse to keep their order
+    ++destination._generation;
+    stack.push(index, parentIndex);
+    while (!stack.empty()) {
+        const auto [current, newParent] = stack.back();
+        stack.pop();
+        const auto newIndex = destination.nodeCount();
+        const auto object = _objects[current];
+        destination.pushNode(object, _ids[current], newParent, _flags[current]);
+        destination._enabled[newIndex] = _enabled[current];
+        destination._visible[newIndex] = _visible[current];
+        destination.linkChild(newParent, newIndex);
+        destination.record(JournalEvent::Added, newIndex, newParent);
+        destination.insertIdIndex(newIndex, _ids[current]);
+        if (object) [[likely]] {
+            UpdateObjectCache(object, &destination, newIndex, newParent);
+            // The source slot must not detach the object when released
+            _objects[current] = nullptr;
+        }
+        const auto &children = _children[current];
+        for (auto it = children.end(); it != children.begin();)
+            stack.push(*--it, newIndex);
+    }
+    // Accumulate destination flag counts from leaves to the branch root, then into its ancestors
+    for (auto &flagIndex : destination._flagIndexes) {
+        for (auto newIndex = destination.nodeCount(); newIndex != first;) {
+            --newIndex;
+            if (HasFlag(destination._flags[newIndex], flagIndex.flag))
+                ++flagIndex.counts[newIndex];
+            if (newIndex != first)
+                flagIndex.counts[destination._parents[newIndex]] += flagIndex.counts[newIndex];
+        }
+        if (const auto count = flagIndex.counts[first]; count)
+            destination.addFlagCount(flagIndex, parentIndex, count);
+    }
+    destination.markAllDirty(parentIndex);
+    destination.markDirtyRoot(first, EffectiveDirtyBit, destination._effectiveDirtyRoots);
+    // Release the branch from this tree
+    if (sourceParent != NullIndex) [[likely]] {
+        unlinkChild(sourceParent, index);
+        for (auto &flagIndex : _flagIndexes) {
+            if (const auto count = flagIndex.counts[index]; count) [[unlikely]]
+                removeFlagCount(flagIndex, sourceParent, count);
+        }
+        markAllDirty(sourceParent);
+    }
+    Core::Vector<Index, Index> releaseStack;
+    releaseBranch(index, releaseStack);
+    ++_generation;
+    return first;
+}
+
+inline void kF::ObjectUtils::Tree::releaseBranch(const Index index, Core::Vector<Index, Index> &stack) noexcept
+{
+    stack.push(index);
+    while (!stack.empty()) {
+        const auto current = stack.back();
+        stack.pop();
+        for (const auto childIndex : _children[current])
+            stack.push(childIndex);
+        record(JournalEvent::Removed, current, _parents[current]);
+        eraseIdIndex(current, _ids[current]);
+        eraseDirtyStates(current);
+        for (auto &flagIndex : _flagIndexes)
+            flagIndex.counts[current] = 0u;
+        if (const auto object = _objects[current]; object) [[likely]]
+            UpdateObjectCache(object, nullptr, NullIndex, NullIndex);
+        _objects[current] = nullptr;
+        _ids[current] = 0u;
+        _parents[current] = NullIndex;
+        _childPositions[current] = NullIndex;
+        _children[current].clear();
+        ++_nodeGenerations[current];
+        _freeList.push(current);
     }
-    for (const auto childIndex : node.children)
-        get(childIndex).parentIndex = NullIndex;
 }
 
 inline void kF::ObjectUtils::Tree::setParent(const Index index, const Index parentIndex) noexcept
 {
-    auto &node = get(index);
+    auto node = get(index);
 
-    setAllDirtyFlags();
     if (node.parentIndex != NullIndex) [[likely]] {
-        auto &parent = get(node.parentIndex);
-        parent.children.erase(std::find(parent.children.begin(), parent.children.end(), index));
+        unlinkChild(node.parentIndex, index);
+        for (auto &flagIndex : _flagIndexes) {
+            if (const auto count = flagIndex.counts[index]; count) [[unlikely]]
+                removeFlagCount(flagIndex, node.parentIndex, count);
+        }
+        markAllDirty(node.parentIndex);
     }
     node.parentIndex = parentIndex;
-    auto &parent = get(parentIndex);
-    parent.children.push(index);
+    linkChild(parentIndex, index);
+    record(JournalEvent::Reparented, index, parentIndex);
+    for (auto &flagIndex : _flagIndexes) {
+        if (const auto count = flagIndex.counts[index]; count) [[unlikely]]
+            addFlagCount(flagIndex, parentIndex, count);
+    }
+    markAllDirty(parentIndex);
+    markDirtyRoot(index, EffectiveDirtyBit, _effectiveDirtyRoots);
+    ++_generation;
 }
 
-inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::find(const HashedName id) const noexcept
+inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::resolve(const NodeHandle handle) const noexcept
+{
+    if (handle.index < nodeCount() && (handle.generation & 1u) && _nodeGenerations[handle.index] == handle.generation) [[likely]]
+        return handle.index;
+    else [[unlikely]]
+        return NullIndex;
+}
+
+inline void kF::ObjectUtils::Tree::setJournaled(const bool value) noexcept
+{
+    if (_journaled == value) [[unlikely]]
+        return;
+    _journaled = value;
+    // Mutations made while the journal is disabled are not recorded, skip a sequence number to mark the gap
+    if (value)
+        ++_journalSequence;
+    else {
+        _journalSequence += _journal.size();
+        _journal.clear();
+    }
+}
+
+inline void kF::ObjectUtils::Tree::record(const JournalEvent event, const Index index, const Index parentIndex) noexcept
+{
+    if (_journaled) [[unlikely]]
+        _journal.push(JournalEntry { event: event, index: index, parentIndex: parentIndex });
+}
+
+template<typename Functor>
+inline void kF::ObjectUtils::Tree::drainJournal(Functor &&functor)
+    noexcept(std::is_nothrow_invocable_v<Functor, const JournalEntry &>)
+{
+    for (const auto &entry : _journal)
+        functor(entry);
+    _journalSequence += _journal.size();
+    _journal.clear();
+}
+
+inline void kF::ObjectUtils::Tree::setChildOrderStable(const bool value) noexcept
+{
+    _childOrderStable = value;
+}
+
+inline void kF::ObjectUtils::Tree::linkChild(const Index parentIndex, const Index index) noexcept
 {
-    for (Index i = 0u; auto &node : _nodes) {
-        if (node.id == id) [[unlikely]]
-            return i;
+    auto &siblings = _children[parentIndex];
+
+    _childPositions[index] = siblings.size();
+    siblings.push(index);
+}
+
+inline void kF::ObjectUtils::Tree::unlinkChild(const Index parentIndex, const Index index) noexcept
+{
+    auto &siblings = _children[parentIndex];
+    const auto position = _childPositions[index];
+
+    if (_childOrderStable) {
+        // Only the following siblings are shifted
+        siblings.erase(siblings.begin() + position);
+        for (auto i = position, count = siblings.size(); i != count; ++i)
+            _childPositions[siblings[i]] = i;
+    } else {
+        // Fill the hole with the last sibling
+        const auto lastIndex = siblings.back();
+        siblings[position] = lastIndex;
+        _childPositions[lastIndex] = position;
+        siblings.pop();
+        if (lastIndex != index)
+            record(JournalEvent::Moved, lastIndex, parentIndex);
+    }
+    _childPositions[index] = NullIndex;
+}
+
+inline void kF::ObjectUtils::Tree::setId(const Index index, const HashedName id) noexcept
+{
+    auto node = get(index);
+
+    if (node.id == id) [[unlikely]]
+        return;
+    eraseIdIndex(index, node.id);
+    node.id = id;
+    insertIdIndex(index, id);
+    record(JournalEvent::IdChanged, index, node.parentIndex);
+    ++_generation;
+    ++_idGeneration;
+}
+
+inline void kF::ObjectUtils::Tree::setFlags(const Index index, const Flags flags) noexcept
+{
+    const auto oldFlags = _flags[index];
+
+    if (oldFlags == flags) [[unlikely]]
+        return;
+    for (auto &flagIndex : _flagIndexes) {
+        const bool had = HasFlag(oldFlags, flagIndex.flag);
+        const bool has = HasFlag(flags, flagIndex.flag);
+        if (had == has) [[likely]]
+            continue;
+        else if (has)
+            addFlagCount(flagIndex, index, 1u);
+        else
+            removeFlagCount(flagIndex, index, 1u);
+    }
+    _flags[index] = flags;
+    ++_stateGeneration;
+    ++_flagsGeneration;
+    record(JournalEvent::FlagsChanged, index, _parents[index]);
+    markDirty(index, DirtyType::Flags);
+}
+
+inline void kF::ObjectUtils::Tree::setFlagIndexed(const Flags flag, const bool value) noexcept
+{
+    if (!value) {
+        const auto it = std::find_if(_flagIndexes.begin(), _flagIndexes.end(),
+            [flag](const auto &flagIndex) { return flagIndex.flag == flag; });
+        if (it != _flagIndexes.end())
+            _flagIndexes.erase(it);
+        return;
+    } else if (isFlagIndexed(flag))
+        return;
+    auto &flagIndex = _flagIndexes.push(FlagIndex { flag: flag });
+    Core::Vector<Index, Index> order;
+    flagIndex.counts.resize(nodeCount(), 0u);
+    // Accumulate counts from leaves to roots
+    collectPreOrder(order);
+    for (auto it = order.end(); it != order.begin();) {
+        const auto index = *--it;
+        if (HasFlag(_flags[index], flag))
+            ++flagIndex.counts[index];
+        if (const auto parentIndex = _parents[index]; parentIndex != NullIndex)
+            flagIndex.counts[parentIndex] += flagIndex.counts[index];
+    }
+}
+
+template<typename Functor>
+inline void kF::ObjectUtils::Tree::forEachFlagged(const Flags flag, Functor &&functor, const Index from) const
+    noexcept(std::is_nothrow_invocable_v<Functor, Index>)
+{
+    const auto flagIndex = findFlagIndex(flag);
+    Core::Vector<Index, Index> stack;
+
+    if (flagIndex && !flagIndex->counts[from]) [[unlikely]]
+        return;
+    stack.push(from);
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop();
+        if (HasFlag(_flags[index], flag))
+            functor(index);
+        const auto &children = _children[index];
+        for (auto it = children.end(); it != children.begin();) {
+            const auto childIndex = *--it;
+            if (!flagIndex || flagIndex->counts[childIndex])
+                stack.push(childIndex);
+        }
+    }
+}
+
+inline const kF::Core::Vector<kF::ObjectUtils::Tree::Index, kF::ObjectUtils::Tree::Index> *
+    kF::ObjectUtils::Tree::flagCounts(const Flags flag) const noexcept
+{
+    if (const auto flagIndex = findFlagIndex(flag); flagIndex) [[likely]]
+        return &flagIndex->counts;
+    return nullptr;
+}
+
+inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::flaggedCount(const Flags flag, const Index from) const noexcept
+{
+    if (const auto flagIndex = findFlagIndex(flag); flagIndex) [[likely]]
+        return flagIndex->counts[from];
+    Index count = 0u;
+    forEachFlagged(flag, [&count](const Index) { ++count; }, from);
+    return count;
+}
+
+inline void kF::ObjectUtils::Tree::setIdIndexed(const bool value) noexcept
+{
+    if (!value) {
+        _idIndex.reset();
+        return;
+    } else if (_idIndex)
+        return;
+    _idIndex = std::make_unique<IdIndex>();
+    _idIndex->reserve(nodeCount());
+    for (Index i = 0u; const auto id : _ids) {
+        insertIdIndex(i, id);
         ++i;
     }
-    return NullIndex;
+}
+
+inline kF::Core::Vector<kF::ObjectUtils::Tree::Index, kF::ObjectUtils::Tree::Index> kF::ObjectUtils::Tree::compact(void) noexcept
+{
+    Core::Vector<Index, Index> remap;
+    Core::Vector<Index, Index> order;
+
+    remap.resize(nodeCount(), NullIndex);
+    collectPreOrder(order);
+    for (Index index = 0u; const auto oldIndex : order)
+        remap[oldIndex] = index++;
+    // Rebuild every column in the new order
+    Core::Vector<Object *, Index> objects;
+    Core::Vector<HashedName, Index> ids;
+    Core::Vector<Index, Index> parents;
+    Core::Vector<bool, Index> enabled;
+    Core::Vector<bool, Index> visible;
+    Core::Vector<Flags, Index> flags;
+    Core::Vector<Children, Index> children;
+    Core::Vector<Index, Index> childPositions;
+    Core::Vector<std::uint8_t, Index> effectiveStates;
+    Core::Vector<std::uint8_t, Index> dirtyStates;
+    const auto newCount = order.size();
+    objects.reserve(newCount);
+    ids.reserve(newCount);
+    parents.reserve(newCount);
+    enabled.reserve(newCount);
+    visible.reserve(newCount);
+    flags.reserve(newCount);
+    children.reserve(newCount);
+    childPositions.reserve(newCount);
+    effectiveStates.reserve(newCount);
+    dirtyStates.reserve(newCount);
+    for (const auto oldIndex : order) {
+        const auto oldParent = _parents[oldIndex];
+        objects.push(_objects[oldIndex]);
+        ids.push(_ids[oldIndex]);
+        parents.push(oldParent != NullIndex ? remap[oldParent] : NullIndex);
+        enabled.push(_enabled[oldIndex]);
+        visible.push(_visible[oldIndex]);
+        flags.push(_flags[oldIndex]);
+        childPositions.push(_childPositions[oldIndex]);
+        effectiveStates.push(_effectiveStates[oldIndex]);
+        dirtyStates.push(_dirtyStates[oldIndex]);
+        auto &nodeChildren = children.push(std::move(_children[oldIndex]));
+        for (auto &childIndex : nodeChildren)
+            childIndex = remap[childIndex];
+    }
+    _objects = std::move(objects);
+    _ids = std::move(ids);
+    _parents = std::move(parents);
+    _enabled = std::move(enabled);
+    _visible = std::move(visible);
+    _flags = std::move(flags);
+    _children = std::move(children);
+    _childPositions = std::move(childPositions);
+    _effectiveStates = std::move(effectiveStates);
+    _dirtyStates = std::move(dirtyStates);
+    _freeList.clear();
+    for (auto &flagIndex : _flagIndexes) {
+        Core::Vector<Index, Index> counts;
+        counts.reserve(newCount);
+        for (const auto oldIndex : order)
+            counts.push(flagIndex.counts[oldIndex]);
+        flagIndex.counts = std::move(counts);
+    }
+    // Follow dirty roots then mark the whole tree as structure changed
+    for (auto &roots : _dirtyRoots) {
+        for (auto &root : roots)
+            root = remap[root];
+    }
+    for (auto &root : _effectiveDirtyRoots)
+        root = remap[root];
+    markDirty(RootIndex, DirtyType::Tree);
+    ++_generation;
+    record(JournalEvent::Compacted, NullIndex, NullIndex);
+    // Nodes that kept their index keep their handles, other slots get a generation no old handle holds
+    // Released slots past the new end keep an even generation until they are pushed again
+    for (Index index = 0u, count = _nodeGenerations.size(); index != count; ++index) {
+        auto &slotGeneration = _nodeGenerations[index];
+        if (index >= newCount)
+            slotGeneration = (slotGeneration + 1u) & ~1u;
+        else if (order[index] != index)
+            slotGeneration = (slotGeneration + 1u) | 1u;
+    }
+    // Rebuild the id index as every index changed
+    if (_idIndex) {
+        setIdIndexed(false);
+        setIdIndexed(true);
+    }
+    // Patch object caches
+    for (Index index = 0u; const auto object : _objects) {
+        if (object) [[likely]]
+            UpdateObjectCache(object, this, index, _parents[index]);
+        ++index;
+    }
+    return remap;
+}
+
+inline std::size_t kF::ObjectUtils::Tree::serializedSize(void) const noexcept
+{
+    Index childCount = 0u;
+
+    for (const auto &children : _children)
+        childCount += children.size();
+    return GetSerializedLayout(nodeCount(), childCount, _freeList.size()).size;
+}
+
+inline void kF::ObjectUtils::Tree::serialize(void * const buffer) const noexcept
+{
+    const auto data = static_cast<std::byte *>(buffer);
+    const auto count = nodeCount();
+    Index childCount = 0u;
+
+    for (const auto &children : _children)
+        childCount += children.size();
+    const auto layout = GetSerializedLayout(count, childCount, _freeList.size());
+    const SerializedHeader header { nodeCount: count, childCount: childCount, freeCount: _freeList.size() };
+    std::memcpy(data, &header, sizeof(SerializedHeader));
+    std::memcpy(data + layout.ids, _ids.data(), count * sizeof(HashedName));
+    std::memcpy(data + layout.parents, _parents.data(), count * sizeof(Index));
+    std::memcpy(data + layout.flags, _flags.data(), count * sizeof(Flags));
+    if (!_freeList.empty())
+        std::memcpy(data + layout.freeList, _freeList.data(), _freeList.size() * sizeof(Index));
+    const auto typeNames = reinterpret_cast<HashedName *>(data + layout.typeNames);
+    const auto childOffsets = reinterpret_cast<Index *>(data + layout.childOffsets);
+    const auto childIndexes = reinterpret_cast<Index *>(data + layout.childIndexes);
+    const auto states = reinterpret_cast<std::uint8_t *>(data + layout.states);
+    Index childOffset = 0u;
+    for (Index i = 0u; i != count; ++i) {
+        typeNames[i] = _objects[i] ? GetObjectTypeName(_objects[i]) : 0u;
+        states[i] = (_enabled[i] ? SerializedEnabledBit : 0u) | (_visible[i] ? SerializedVisibleBit : 0u);
+        childOffsets[i] = childOffset;
+        std::copy(_children[i].begin(), _children[i].end(), childIndexes + childOffset);
+        childOffset += _children[i].size();
+    }
+    childOffsets[count] = childOffset;
+}
+
+inline bool kF::ObjectUtils::Tree::deserialize(const void * const buffer, const std::size_t size) noexcept
+{
+    const auto data = static_cast<const std::byte *>(buffer);
+
+    if (!IsSerializedValid(data, size)) [[unlikely]]
+        return false;
+    SerializedHeader header;
+    std::memcpy(&header, data, sizeof(SerializedHeader));
+    const auto count = header.nodeCount;
+    const auto layout = GetSerializedLayout(count, header.childCount, header.freeCount);
+    // Detach previously bound objects so that they don't point into the replaced tree
+    for (const auto object : _objects) {
+        if (object)
+            UpdateObjectCache(object, nullptr, NullIndex, NullIndex);
+    }
+    // Bulk copy columns
+    _objects.clear();
+    _objects.resize(count, nullptr);
+    _ids.resize(count);
+    std::memcpy(_ids.data(), data + layout.ids, count * sizeof(HashedName));
+    _parents.resize(count);
+    std::memcpy(_parents.data(), data + layout.parents, count * sizeof(Index));
+    _flags.resize(count);
+    std::memcpy(_flags.data(), data + layout.flags, count * sizeof(Flags));
+    _freeList.resize(header.freeCount);
+    if (header.freeCount)
+        std::memcpy(_freeList.data(), data + layout.freeList, header.freeCount * sizeof(Index));
+    _enabled.resize(count);
+    _visible.resize(count);
+    const auto states = reinterpret_cast<const std::uint8_t *>(data + layout.states);
+    for (Index i = 0u; i != count; ++i) {
+        _enabled[i] = states[i] & SerializedEnabledBit;
+        _visible[i] = states[i] & SerializedVisibleBit;
+    }
+    _children.clear();
+    _children.resize(count);
+    _childPositions.clear();
+    _childPositions.resize(count, NullIndex);
+    const auto childOffsets = reinterpret_cast<const Index *>(data + layout.childOffsets);
+    const auto childIndexes = reinterpret_cast<const Index *>(data + layout.childIndexes);
+    for (Index i = 0u; i != count; ++i) {
+        auto &children = _children[i];
+        children.resize(childOffsets[i + 1u] - childOffsets[i]);
+        std::copy(childIndexes + childOffsets[i], childIndexes + childOffsets[i + 1u], children.begin());
+        for (Index position = 0u; const auto childIndex : children)
+            _childPositions[childIndex] = position++;
+    }
+    // Reset derived states then mark the whole tree as changed
+    _effectiveStates.clear();
+    _effectiveStates.resize(count, static_cast<std::uint8_t>(EffectiveEnabledBit | EffectiveVisibleBit));
+    _dirtyStates.clear();
+    _dirtyStates.resize(count, std::uint8_t {});
+    for (auto &roots : _dirtyRoots)
+        roots.clear();
+    _effectiveDirtyRoots.clear();
+    markAllDirty(RootIndex);
+    markDirtyRoot(RootIndex, EffectiveDirtyBit, _effectiveDirtyRoots);
+    ++_generation;
+    record(JournalEvent::Reset, NullIndex, NullIndex);
+    // Every slot gets a generation no handle of the replaced tree holds
+    const auto previousCount = _nodeGenerations.size();
+    for (Index index = 0u; index != previousCount; ++index) {
+        auto &slotGeneration = _nodeGenerations[index];
+        slotGeneration = index < count ? (slotGeneration + 1u) | 1u : (slotGeneration + 1u) & ~1u;
+    }
+    if (previousCount < count)
+        _nodeGenerations.resize(count, 1u);
+    for (const auto freeIndex : _freeList)
+        ++_nodeGenerations[freeIndex];
+    // Rebuild enabled indexes
+    for (auto &flagIndex : _flagIndexes) {
+        const auto flag = flagIndex.flag;
+        setFlagIndexed(flag, false);
+        setFlagIndexed(flag, true);
+    }
+    if (_idIndex) {
+        setIdIndexed(false);
+        setIdIndexed(true);
+    }
+    return true;
+}
+
+inline const kF::HashedName *kF::ObjectUtils::Tree::SerializedTypeNames(const void * const buffer) noexcept
+{
+    const auto data = static_cast<const std::byte *>(buffer);
+    SerializedHeader header;
+
+    std::memcpy(&header, data, sizeof(SerializedHeader));
+    return reinterpret_cast<const HashedName *>(data + GetSerializedLayout(header.nodeCount, header.childCount, header.freeCount).typeNames);
+}
+
+inline void kF::ObjectUtils::Tree::bindObject(const Index index, Object * const object) noexcept
+{
+    _objects[index] = object;
+    if (object) [[likely]]
+        UpdateObjectCache(object, this, index, _parents[index]);
+}
+
+inline kF::ObjectUtils::Tree::SerializedLayout kF::ObjectUtils::Tree::GetSerializedLayout(
+        const Index nodeCount, const Index childCount, const Index freeCount) noexcept
+{
+    SerializedLayout layout;
+    std::size_t offset = sizeof(SerializedHeader);
+
+    const auto push = [&offset](const std::size_t size) {
+        const auto begin = offset;
+        offset += size;
+        return begin;
+    };
+    layout.ids = push(nodeCount * sizeof(HashedName));
+    layout.parents = push(nodeCount * sizeof(Index));
+    layout.typeNames = push(nodeCount * sizeof(HashedName));
+    layout.childOffsets = push((nodeCount + std::size_t { 1u }) * sizeof(Index));
+    layout.childIndexes = push(childCount * sizeof(Index));
+    layout.freeList = push(freeCount * sizeof(Index));
+    layout.flags = push(nodeCount * sizeof(Flags));
+    layout.states = push(nodeCount * sizeof(std::uint8_t));
+    // Keep serialized trees 4 bytes aligned so they can be concatenated
+    layout.size = (offset + 3u) & ~std::size_t { 3u };
+    return layout;
+}
+
+inline bool kF::ObjectUtils::Tree::IsSerializedValid(const std::byte * const data, const std::size_t size) noexcept
+{
+    SerializedHeader header;
+
+    if (size < sizeof(SerializedHeader)) [[unlikely]]
+        return false;
+    std::memcpy(&header, data, sizeof(SerializedHeader));
+    if (header.magic != SerializedMagic || header.version != SerializedVersion || !header.nodeCount) [[unlikely]]
+        return false;
+    const auto count = header.nodeCount;
+    const auto layout = GetSerializedLayout(count, header.childCount, header.freeCount);
+    if (size < layout.size) [[unlikely]]
+        return false;
+    // Check every index so a corrupted file can't make the tree read out of bounds
+    const auto parents = reinterpret_cast<const Index *>(data + layout.parents);
+    const auto childOffsets = reinterpret_cast<const Index *>(data + layout.childOffsets);
+    const auto childIndexes = reinterpret_cast<const Index *>(data + layout.childIndexes);
+    const auto freeList = reinterpret_cast<const Index *>(data + layout.freeList);
+    if (childOffsets[0] != 0u || childOffsets[count] != header.childCount || parents[RootIndex] != NullIndex) [[unlikely]]
+        return false;
+    for (Index i = 0u; i != count; ++i) {
+        if ((parents[i] >= count && parents[i] != NullIndex) || childOffsets[i] > childOffsets[i + 1u]) [[unlikely]]
+            return false;
+    }
+    // Then check that nodes form a forest, so that no traversal can loop forever
+    constexpr std::uint8_t FreeMark = 0b1;
+    constexpr std::uint8_t ChildMark = 0b10;
+    constexpr std::uint8_t VisitedMark = 0b100;
+    Core::Vector<std::uint8_t, Index> marks;
+    Core::Vector<Index, Index> stack;
+    Index linkedCount = 0u;
+    marks.resize(count, std::uint8_t {});
+    // Free slots are unique and detached
+    for (Index i = 0u; i != header.freeCount; ++i) {
+        const auto freeIndex = freeList[i];
+        if (freeIndex >= count || freeIndex == RootIndex || (marks[freeIndex] & FreeMark)
+                || parents[freeIndex] != NullIndex || childOffsets[freeIndex] != childOffsets[freeIndex + 1u]) [[unlikely]]
+            return false;
+        marks[freeIndex] |= FreeMark;
+    }
+    // Each child is listed once, by its parent, and every node holding a parent is listed
+    for (Index i = 0u; i != count; ++i) {
+        if (!(marks[i] & FreeMark) && parents[i] != NullIndex)
+            ++linkedCount;
+        for (auto it = childIndexes + childOffsets[i], end = childIndexes + childOffsets[i + 1u]; it != end; ++it) {
+            if (*it >= count || parents[*it] != i || (marks[*it] & (FreeMark | ChildMark))) [[unlikely]]
+                return false;
+            marks[*it] |= ChildMark;
+        }
+    }
+    if (linkedCount != header.childCount) [[unlikely]]
+        return false;
+    // Nodes unreachable from the root or an orphan branch belong to a cycle
+    for (Index root = RootIndex; root != count; ++root) {
+        if ((marks[root] & FreeMark) || parents[root] != NullIndex)
+            continue;
+        stack.push(root);
+        while (!stack.empty()) {
+            const auto index = stack.back();
+            stack.pop();
+            marks[index] |= VisitedMark;
+            for (auto it = childIndexes + childOffsets[index], end = childIndexes + childOffsets[index + 1u]; it != end; ++it)
+                stack.push(*it);
+        }
+    }
+    for (Index i = 0u; i != count; ++i) {
+        if (!(marks[i] & (FreeMark | VisitedMark))) [[unlikely]]
+            return false;
+    }
+    return true;
+}
+
+inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::find(const HashedName id) const noexcept
+{
+    if (!_idIndex)
+        return findLinear(id);
+    // The root node is the first node holding a null id
+    if (!id) [[unlikely]]
+        return RootIndex;
+    const auto [begin, end] = _idIndex->equal_range(id);
+    Index index = NullIndex;
+    for (auto it = begin; it != end; ++it)
+        index = std::min(index, it->second);
+    return index;
+}
+
+inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::findLinear(const HashedName id) const noexcept
+{
+    const auto begin = _ids.begin();
+    const auto end = _ids.end();
+    const auto it = std::find(begin, end, id);
+
+    if (it != end) [[likely]]
+        return static_cast<Index>(std::distance(begin, it));
+    else [[unlikely]]
+        return NullIndex;
+}
+
+inline void kF::ObjectUtils::Tree::setScopeCached(const bool value) noexcept
+{
+    if (!value)
+        _scopeCache.reset();
+    else if (!_scopeCache)
+        _scopeCache = std::make_unique<ScopeCache>();
 }
 
 inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::findInScope(const HashedName id, const Index from) const noexcept
 {
-    auto &node = get(from);
+    if (!_scopeCache) [[likely]]
+        return findInScopeLinear(id, from);
+    // Every entry is outdated once the structure changed
+    if (_scopeCache->generation != _generation) [[unlikely]] {
+        _scopeCache->entries.clear();
+        _scopeCache->generation = _generation;
+    }
+    const auto key = (static_cast<std::uint64_t>(from) << 32u) | id;
+    const auto [it, inserted] = _scopeCache->entries.try_emplace(key, NullIndex);
+    if (inserted) [[unlikely]]
+        it->second = findInScopeLinear(id, from);
+    return it->second;
+}
 
-    if (node.id == id) [[unlikely]]
+inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::findPath(const Index from, const HashedName * const begin, const HashedName * const end) const noexcept
+{
+    auto index = from;
+
+    for (auto it = begin; it != end; ++it) {
+        const auto &children = _children[index];
+        const auto child = std::find_if(children.begin(), children.end(),
+            [this, id = *it](const Index childIndex) { return _ids[childIndex] == id; });
+        if (child == children.end()) [[unlikely]]
+            return NullIndex;
+        index = *child;
+    }
+    return index;
+}
+
+inline kF::ObjectUtils::Tree::Index kF::ObjectUtils::Tree::findInScopeLinear(const HashedName id, const Index from) const noexcept
+{
+    if (_ids[from] == id) [[unlikely]]
         return from;
     // Start to search in close children
-    for (const auto childIndex : node.children) {
-        auto &child = get(childIndex);
-        if (child.id == id) [[unlikely]]
+    for (const auto childIndex : _children[from]) {
+        if (_ids[childIndex] == id) [[unlikely]]
             return childIndex;
     }
     // If not found, search for parents and their close children
-    for (auto parentIndex = node.parentIndex; parentIndex != NullIndex;) {
-        auto &parent = get(parentIndex);
-        if (parent.id == id) [[unlikely]]
+    for (auto parentIndex = _parents[from]; parentIndex != NullIndex;) {
+        if (_ids[parentIndex] == id) [[unlikely]]
             return parentIndex;
-        for (const auto childIndex : parent.children) {
-            auto &child = get(childIndex);
-            if (child.id == id) [[unlikely]]
+        for (const auto childIndex : _children[parentIndex]) {
+            if (_ids[childIndex] == id) [[unlikely]]
                 return childIndex;
         }
-        parentIndex = parent.parentIndex;
+        parentIndex = _parents[parentIndex];
     }
     return NullIndex;
 }
 
-inline void kF::ObjectUtils::Tree::setAllDirtyFlags(void) noexcept
+inline void kF::ObjectUtils::Tree::insertIdIndex(const Index index, const HashedName id) noexcept
 {
-    // TODO: check if normal setter has same speed in benchmarks as uint32 setter
-    _treeDirty = true;
-    _visibleDirty = true;
-    _enabledDirty = true;
-}
\ No newline at end of file
+    // Null ids are never indexed as most nodes don't have any
+    if (_idIndex && id) [[unlikely]]
+        _idIndex->emplace(id, index);
+}
+
+inline void kF::ObjectUtils::Tree::eraseIdIndex(const Index index, const HashedName id) noexcept
+{
+    if (!_idIndex || !id) [[likely]]
+        return;
+    const auto [begin, end] = _idIndex->equal_range(id);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second == index) {
+            _idIndex->erase(it);
+            return;
+        }
+    }
+}
+
+inline const kF::ObjectUtils::Tree::FlagIndex *kF::ObjectUtils::Tree::findFlagIndex(const Flags flag) const noexcept
+{
+    for (const auto &flagIndex : _flagIndexes) {
+        if (flagIndex.flag == flag)
+            return &flagIndex;
+    }
+    return nullptr;
+}
+
+inline void kF::ObjectUtils::Tree::addFlagCount(FlagIndex &flagIndex, const Index index, const Index count) noexcept
+{
+    for (auto it = index; it != NullIndex; it = _parents[it])
+        flagIndex.counts[it] += count;
+}
+
+inline void kF::ObjectUtils::Tree::removeFlagCount(FlagIndex &flagIndex, const Index index, const Index count) noexcept
+{
+    for (auto it = index; it != NullIndex; it = _parents[it])
+        flagIndex.counts[it] -= count;
+}
+
+inline void kF::ObjectUtils::Tree::collectPreOrder(Core::Vector<Index, Index> &order) const noexcept
+{
+    const auto count = nodeCount();
+    Core::Vector<bool, Index> freeSlots;
+    Core::Vector<Index, Index> stack;
+
+    freeSlots.resize(count, false);
+    for (const auto index : _freeList)
+        freeSlots[index] = true;
+    order.reserve(order.size() + count - _freeList.size());
+    for (Index root = RootIndex; root != count; ++root) {
+        // Only the root and orphan branches are roots of a traversal
+        if (freeSlots[root] || (root != RootIndex && _parents[root] != NullIndex))
+            continue;
+        stack.push(root);
+        while (!stack.empty()) {
+            const auto index = stack.back();
+            stack.pop();
+            order.push(index);
+            const auto &children = _children[index];
+            for (auto it = children.end(); it != children.begin();)
+                stack.push(*--it);
+        }
+    }
+}
+
+inline void kF::ObjectUtils::Tree::pushNode(Object * const object, const HashedName id, const Index parentIndex, const Flags flags) noexcept
+{
+    _objects.push(object);
+    _ids.push(id);
+    _parents.push(parentIndex);
+    _enabled.push(true);
+    _visible.push(true);
+    _flags.push(flags);
+    _children.push();
+    _childPositions.push(NullIndex);
+    // Slots released past the end by 'compact' or 'deserialize' keep their generation history
+    if (const auto index = _childPositions.size() - 1u; index < _nodeGenerations.size())
+        ++_nodeGenerations[index];
+    else
+        _nodeGenerations.push(1u);
+    _effectiveStates.push(static_cast<std::uint8_t>(EffectiveEnabledBit | EffectiveVisibleBit));
+    _dirtyStates.push(std::uint8_t {});
+    for (auto &flagIndex : _flagIndexes)
+        flagIndex.counts.push(0u);
+}
+
+inline void kF::ObjectUtils::Tree::setEnabled(const Index index, const bool state) noexcept
+{
+    if (_enabled[index] == state) [[unlikely]]
+        return;
+    _enabled[index] = state;
+    ++_stateGeneration;
+    ++_enabledGeneration;
+    record(JournalEvent::EnabledChanged, index, _parents[index]);
+    markDirty(index, DirtyType::Enabled);
+    markDirtyRoot(index, EffectiveDirtyBit, _effectiveDirtyRoots);
+}
+
+inline void kF::ObjectUtils::Tree::setVisible(const Index index, const bool state) noexcept
+{
+    if (_visible[index] == state) [[unlikely]]
+        return;
+    _visible[index] = state;
+    ++_stateGeneration;
+    record(JournalEvent::VisibleChanged, index, _parents[index]);
+    markDirty(index, DirtyType::Visible);
+    markDirtyRoot(index, EffectiveDirtyBit, _effectiveDirtyRoots);
+}
+
+inline bool kF::ObjectUtils::Tree::effectivelyEnabled(const Index index) noexcept
+{
+    if (isEffectiveStateDirty()) [[unlikely]]
+        updateEffectiveStates();
+    return _effectiveStates[index] & EffectiveEnabledBit;
+}
+
+inline bool kF::ObjectUtils::Tree::effectivelyVisible(const Index index) noexcept
+{
+    if (isEffectiveStateDirty()) [[unlikely]]
+        updateEffectiveStates();
+    return _effectiveStates[index] & EffectiveVisibleBit;
+}
+
+inline void kF::ObjectUtils::Tree::updateEffectiveStates(void) noexcept
+{
+    Core::Vector<Index, Index> stack;
+
+    for (const auto root : _effectiveDirtyRoots) {
+        _dirtyStates[root] &= ~EffectiveDirtyBit;
+        stack.push(root);
+        while (!stack.empty()) {
+            const auto index = stack.back();
+            stack.pop();
+            // Parents are always processed before their children
+            const auto parentIndex = _parents[index];
+            const std::uint8_t parentStates = parentIndex != NullIndex ? _effectiveStates[parentIndex] : (EffectiveEnabledBit | EffectiveVisibleBit);
+            const std::uint8_t states = (_enabled[index] ? EffectiveEnabledBit : 0u) | (_visible[index] ? EffectiveVisibleBit : 0u);
+            _effectiveStates[index] = parentStates & states;
+            for (const auto childIndex : _children[index])
+                stack.push(childIndex);
+        }
+    }
+    _effectiveDirtyRoots.clear();
+}
+
+inline void kF::ObjectUtils::Tree::markDirty(const Index index, const DirtyType type) noexcept
+{
+    markDirtyRoot(index, static_cast<std::uint8_t>(type), _dirtyRoots[DirtyTypeIndex(type)]);
+}
+
+inline void kF::ObjectUtils::Tree::markDirtyRoot(const Index index, const std::uint8_t mask, DirtyRoots &roots) noexcept
+{
+    // Skip if the node or one of its ancestors is already dirty
+    for (auto it = index; it != NullIndex; it = _parents[it]) {
+        if (_dirtyStates[it] & mask) [[likely]]
+            return;
+    }
+    _dirtyStates[index] |= mask;
+    roots.push(index);
+}
+
+inline void kF::ObjectUtils::Tree::clearDirty(const DirtyType type) noexcept
+{
+    const auto mask = static_cast<std::uint8_t>(type);
+    auto &roots = _dirtyRoots[DirtyTypeIndex(type)];
+
+    for (const auto root : roots)
+        _dirtyStates[root] &= ~mask;
+    roots.clear();
+}
+
+inline void kF::ObjectUtils::Tree::markAllDirty(const Index index) noexcept
+{
+    markDirty(index, DirtyType::Tree);
+    markDirty(index, DirtyType::Enabled);
+    markDirty(index, DirtyType::Visible);
+    markDirty(index, DirtyType::Flags);
+}
+
+inline void kF::ObjectUtils::Tree::setDirtyFlag(const DirtyType type, const bool value) noexcept
+{
+    if (value)
+        markDirty(RootIndex, type);
+    else
+        clearDirty(type);
+}
+
+inline void kF::ObjectUtils::Tree::eraseDirtyStates(const Index index) noexcept
+{
+    const auto states = _dirtyStates[index];
+
+    if (!states) [[likely]]
+        return;
+    for (std::uint8_t mask = 1u; auto &roots : _dirtyRoots) {
+        if (states & mask)
+            roots.erase(std::find(roots.begin(), roots.end(), index));
+        mask <<= 1u;
+    }
+    if (states & EffectiveDirtyBit)
+        _effectiveDirtyRoots.erase(std::find(_effectiveDirtyRoots.begin(), _effectiveDirtyRoots.end(), index));
+    _dirtyStates[index] = 0u;
+}
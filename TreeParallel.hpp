@@ -0,0 +1,86 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Parallel visits of a tree of objects
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "Tree.hpp"
+
+namespace kF::ObjectUtils
+{
+    class TreeWorkerPool;
+}
+
+/** @brief Persistent threads running the parallel visits of trees
+ *
+ *  Workers are created once and sleep between runs, so a per-frame visit doesn't pay any thread creation
+ *  Definitions of 'Tree::parallelVisit' and 'Tree::parallelCollect' live in this header
+ *  so that users of the tree don't pull threading headers
+*/
+class kF::ObjectUtils::TreeWorkerPool
+{
+public:
+    /** @brief Get the pool used by tree visits, created on first use with a worker per additional hardware thread */
+    [[nodiscard]] static TreeWorkerPool &Get(void);
+
+
+    /** @brief Construct the pool and start its workers
+     *  If a worker can't be started, the started ones are joined before rethrowing */
+    explicit TreeWorkerPool(const std::uint32_t workerCount);
+
+    /** @brief A pool can't be copied nor moved since its workers refer to it */
+    TreeWorkerPool(const TreeWorkerPool &other) = delete;
+    TreeWorkerPool(TreeWorkerPool &&other) = delete;
+
+    /** @brief Destructor, join every worker */
+    ~TreeWorkerPool(void) noexcept;
+
+
+    /** @brief Get the number of workers, the calling thread of a run excluded */
+    [[nodiscard]] std::uint32_t workerCount(void) const noexcept { return _threads.size(); }
+
+
+    /** @brief Call 'job(jobIndex)' once for each index in [0, count), the calling thread runs index 0
+     *  'count' is clamped to the number of workers plus the calling thread
+     *  Returns once every job is done, then rethrows the first exception thrown by a job (if any)
+     *  A run requested from inside a job only calls 'job(0)' on its calling thread */
+    template<typename Job>
+    void run(const std::uint32_t count, Job &&job);
+
+private:
+    /** @brief Type-erased job of a run */
+    using JobFunction = void(*)(void * const, const std::uint32_t);
+
+    Core::Vector<std::thread, std::uint32_t> _threads {};
+    std::mutex _runMutex {};
+    std::mutex _mutex {};
+    std::condition_variable _wakeUp {};
+    std::condition_variable _done {};
+    JobFunction _job { nullptr };
+    void *_jobData { nullptr };
+    std::exception_ptr _exception {};
+    std::uint64_t _runGeneration { 0u };
+    std::uint32_t _jobCount { 0u };
+    std::uint32_t _pending { 0u };
+    bool _stop { false };
+
+    static inline thread_local bool _InsideJob { false };
+
+    /** @brief Run loop of a worker, 'jobIndex' starts at 1 */
+    void workerMain(const std::uint32_t jobIndex) noexcept;
+
+    /** @brief Implementation of 'run' */
+    void runJob(const std::uint32_t count, const JobFunction job, void * const data);
+
+    /** @brief Stop and join every started worker */
+    void stop(void) noexcept;
+};
+
+#include "TreeParallel.ipp"
@@ -0,0 +1,320 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Parallel visits of a tree of objects
+ */
+
+inline kF::ObjectUtils::TreeWorkerPool &kF::ObjectUtils::TreeWorkerPool::Get(void)
+{
+    static TreeWorkerPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1u);
+
+    return pool;
+}
+
+inline kF::ObjectUtils::TreeWorkerPool::TreeWorkerPool(const std::uint32_t workerCount)
+{
+    try {
+        _threads.reserve(workerCount);
+        for (std::uint32_t i = 0u; i != workerCount; ++i)
+            _threads.push(&TreeWorkerPool::workerMain, this, i + 1u);
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+inline kF::ObjectUtils::TreeWorkerPool::~TreeWorkerPool(void) noexcept
+{
+    stop();
+}
+
+inline void kF::ObjectUtils::TreeWorkerPool::stop(void) noexcept
+{
+    {
+        std::lock_guard lock(_mutex);
+        _stop = true;
+    }
+    _wakeUp.notify_all();
+    for (auto &thread : _threads)
+        thread.join();
+    _threads.clear();
+}
+
+template<typename Job>
+inline void kF::ObjectUtils::TreeWorkerPool::run(const std::uint32_t count, Job &&job)
+{
+    using JobType = std::remove_reference_t<Job>;
+
+    runJob(count, [](void * const data, const std::uint32_t jobIndex) {
+        (*static_cast<JobType *>(data))(jobIndex);
+    }, const_cast<void *>(static_cast<const void *>(std::addressof(job))));
+}
+
+inline void kF::ObjectUtils::TreeWorkerPool::runJob(const std::uint32_t count, const JobFunction job, void * const data)
+{
+    // Nested runs would wait for workers busy with the enclosing run
+    if (_InsideJob || count <= 1u || _threads.empty()) [[unlikely]] {
+        job(data, 0u);
+        return;
+    }
+    std::lock_guard runLock(_runMutex);
+    const auto workers = std::min(count - 1u, workerCount());
+    std::exception_ptr exception;
+
+    {
+        std::lock_guard lock(_mutex);
+        _job = job;
+        _jobData = data;
+        _jobCount = workers;
+        _pending = workers;
+        _exception = nullptr;
+        ++_runGeneration;
+    }
+    _wakeUp.notify_all();
+    _InsideJob = true;
+    try {
+        job(data, 0u);
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    _InsideJob = false;
+    {
+        std::unique_lock lock(_mutex);
+        _done.wait(lock, [this] { return !_pending; });
+        if (!exception)
+            exception = std::exchange(_exception, nullptr);
+    }
+    if (exception) [[unlikely]]
+        std::rethrow_exception(exception);
+}
+
+inline void kF::ObjectUtils::TreeWorkerPool::workerMain(const std::uint32_t jobIndex) noexcept
+{
+    std::uint64_t generation = 0u;
+
+    _InsideJob = true;
+    while (true) {
+        JobFunction job;
+        void *data;
+        {
+            std::unique_lock lock(_mutex);
+            _wakeUp.wait(lock, [this, generation] { return _stop || _runGeneration != generation; });
+            if (_stop)
+                return;
+            generation = _runGeneration;
+            if (jobIndex > _jobCount)
+                continue;
+            job = _job;
+            data = _jobData;
+        }
+        std::exception_ptr exception;
+        try {
+            job(data, jobIndex);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        std::lock_guard lock(_mutex);
+        if (exception && !_exception) [[unlikely]]
+            _exception = std::move(exception);
+        if (!--_pending)
+            _done.notify_one();
+    }
+}
+
+template<typename Functor>
+inline void kF::ObjectUtils::Tree::parallelVisit(const Index root, Functor &&functor,
+        const VisitFilter filter, const std::uint32_t threadCount) const
+{
+    const auto flagIndex = findFlagIndex(filter.flag);
+    const auto count = GetVisitThreadCount(threadCount);
+    const auto items = splitParallelVisit(root, filter, flagIndex, count);
+    auto visitor = [&functor](const Index index, const std::uint32_t) -> bool {
+        if constexpr (std::is_same_v<std::invoke_result_t<Functor &, Index>, bool>)
+            return functor(index);
+        else {
+            functor(index);
+            return true;
+        }
+    };
+
+    runParallelVisit(items, visitor, filter, flagIndex, count);
+}
+
+template<typename Predicate>
+inline kF::Core::Vector<kF::ObjectUtils::Tree::Index, kF::ObjectUtils::Tree::Index> kF::ObjectUtils::Tree::parallelCollect(
+        const Index root, Predicate &&predicate, const VisitFilter filter, const std::uint32_t threadCount) const
+{
+    const auto flagIndex = findFlagIndex(filter.flag);
+    const auto count = GetVisitThreadCount(threadCount);
+    const auto items = splitParallelVisit(root, filter, flagIndex, count);
+    Core::Vector<Core::Vector<Index, Index>, std::uint32_t> slots;
+    Core::Vector<Index, Index> result;
+    auto visitor = [&predicate, &slots](const Index index, const std::uint32_t slot) -> bool {
+        if (predicate(index))
+            slots[slot].push(index);
+        return true;
+    };
+
+    // Each slot is only written by the thread owning its item
+    slots.resize(items.size());
+    runParallelVisit(items, visitor, filter, flagIndex, count);
+    // Merge in items order which is pre-order
+    Index total = 0u;
+    for (const auto &slot : slots)
+        total += slot.size();
+    result.reserve(total);
+    for (const auto &slot : slots) {
+        for (const auto index : slot)
+            result.push(index);
+    }
+    return result;
+}
+
+template<typename Visitor>
+inline void kF::ObjectUtils::Tree::runParallelVisit(const Core::Vector<VisitItem, std::uint32_t> &items, Visitor &visitor,
+        const VisitFilter &filter, const FlagIndex * const flagIndex, const std::uint32_t threadCount) const
+{
+    constexpr auto NoSkip = std::numeric_limits<std::uint32_t>::max();
+
+    /** @brief Range of tasks of a worker, begin in the high half and end in the low half
+     *  The owner pops from the begin while thieves steal from the end */
+    struct alignas_cacheline WorkerRange
+    {
+        std::atomic<std::uint64_t> range { 0u };
+    };
+
+    Core::Vector<std::uint32_t, std::uint32_t> tasks;
+    auto skipDepth = NoSkip;
+
+    // Visit expanded nodes on the calling thread, subtrees of pruned nodes are skipped
+    for (std::uint32_t slot = 0u; const auto &item : items) {
+        if (skipDepth != NoSkip && item.depth > skipDepth) {
+            ++slot;
+            continue;
+        }
+        skipDepth = NoSkip;
+        if (!item.expanded)
+            tasks.push(slot);
+        else if (HasFlag(_flags[item.index], filter.flag) && !visitor(item.index, slot))
+            skipDepth = item.depth;
+        ++slot;
+    }
+    if (tasks.empty())
+        return;
+
+    // Distribute contiguous task ranges to workers
+    auto &pool = TreeWorkerPool::Get();
+    const auto workerCount = std::min({ threadCount, pool.workerCount() + 1u, tasks.size() });
+    const auto ranges = std::make_unique<WorkerRange[]>(workerCount);
+    for (std::uint32_t i = 0u; i != workerCount; ++i) {
+        const std::uint64_t begin = static_cast<std::uint64_t>(tasks.size()) * i / workerCount;
+        const std::uint64_t end = static_cast<std::uint64_t>(tasks.size()) * (i + 1u) / workerCount;
+        ranges[i].range.store((begin << 32u) | end, std::memory_order_relaxed);
+    }
+    const auto take = [](WorkerRange &worker, std::uint32_t &task, const bool steal) -> bool {
+        auto range = worker.range.load(std::memory_order_acquire);
+        while (true) {
+            const auto begin = static_cast<std::uint32_t>(range >> 32u);
+            const auto end = static_cast<std::uint32_t>(range);
+            if (begin >= end)
+                return false;
+            const std::uint64_t next = steal
+                ? (static_cast<std::uint64_t>(begin) << 32u) | (end - 1u)
+                : (static_cast<std::uint64_t>(begin + 1u) << 32u) | end;
+            if (worker.range.compare_exchange_weak(range, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                task = steal ? end - 1u : begin;
+                return true;
+            }
+        }
+    };
+    // Once a worker failed, the others stop taking tasks
+    std::atomic<bool> failed { false };
+    const auto work = [&](const std::uint32_t workerIndex) {
+        Core::Vector<Index, Index> stack;
+        std::uint32_t task;
+        while (!failed.load(std::memory_order_relaxed)) {
+            bool found = take(ranges[workerIndex], task, false);
+            for (std::uint32_t i = 1u; !found && i != workerCount; ++i)
+                found = take(ranges[(workerIndex + i) % workerCount], task, true);
+            if (!found)
+                return;
+            const auto slot = tasks[task];
+            try {
+                visitSubtree(items[slot].index, slot, visitor, filter, flagIndex, stack);
+            } catch (...) {
+                failed.store(true, std::memory_order_relaxed);
+                throw;
+            }
+        }
+    };
+
+    // The calling thread is the first worker
+    pool.run(workerCount, work);
+}
+
+template<typename Visitor>
+inline void kF::ObjectUtils::Tree::visitSubtree(const Index root, const std::uint32_t slot, Visitor &visitor,
+        const VisitFilter &filter, const FlagIndex * const flagIndex, Core::Vector<Index, Index> &stack) const
+{
+    stack.push(root);
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop();
+        if (isVisitPruned(index, filter, flagIndex))
+            continue;
+        else if (HasFlag(_flags[index], filter.flag) && !visitor(index, slot))
+            continue;
+        const auto &children = _children[index];
+        for (auto it = children.end(); it != children.begin();)
+            stack.push(*--it);
+    }
+}
+
+inline bool kF::ObjectUtils::Tree::isVisitPruned(const Index index, const VisitFilter &filter, const FlagIndex * const flagIndex) const noexcept
+{
+    return (filter.enabledOnly && !_enabled[index])
+        || (filter.visibleOnly && !_visible[index])
+        || (flagIndex && !flagIndex->counts[index]);
+}
+
+inline kF::Core::Vector<kF::ObjectUtils::Tree::VisitItem, std::uint32_t> kF::ObjectUtils::Tree::splitParallelVisit(
+        const Index root, const VisitFilter &filter, const FlagIndex * const flagIndex, const std::uint32_t threadCount) const noexcept
+{
+    const auto target = threadCount * VisitTasksPerThread;
+    Core::Vector<VisitItem, std::uint32_t> items;
+    Core::Vector<VisitItem, std::uint32_t> next;
+
+    if (isVisitPruned(root, filter, flagIndex))
+        return items;
+    items.push(VisitItem { index: root, depth: 0u, expanded: false });
+    // Expand subtree items into their node and their children until there are enough items
+    for (std::uint32_t pass = 0u; pass != VisitMaxRefinePasses && items.size() < target; ++pass) {
+        bool changed = false;
+        next.clear();
+        next.reserve(items.size());
+        for (std::uint32_t i = 0u; i != items.size(); ++i) {
+            const auto &item = items[i];
+            const auto &children = _children[item.index];
+            if (item.expanded || children.empty() || next.size() + (items.size() - i) >= target) {
+                next.push(item);
+                continue;
+            }
+            next.push(VisitItem { index: item.index, depth: item.depth, expanded: true });
+            for (const auto childIndex : children) {
+                if (!isVisitPruned(childIndex, filter, flagIndex))
+                    next.push(VisitItem { index: childIndex, depth: item.depth + 1u, expanded: false });
+            }
+            changed = true;
+        }
+        std::swap(items, next);
+        if (!changed)
+            break;
+    }
+    return items;
+}
+
+inline std::uint32_t kF::ObjectUtils::Tree::GetVisitThreadCount(const std::uint32_t threadCount)
+{
+    if (threadCount) [[likely]]
+        return threadCount;
+    return TreeWorkerPool::Get().workerCount() + 1u;
+}
@@ -0,0 +1,69 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Compiled hierarchical path of a tree of objects
+ */
+
+#pragma once
+
+#include <initializer_list>
+#include <string_view>
+
+#include "Tree.hpp"
+
+namespace kF::ObjectUtils
+{
+    class TreePath;
+}
+
+/** @brief A compiled path of hashed names, resolved from a node through its descendants ("panel.button")
+ *  The last resolution is memoized until the tree structure changes */
+class kF::ObjectUtils::TreePath
+{
+public:
+    /** @brief Index of a node in a tree */
+    using Index = Tree::Index;
+
+    /** @brief Separator of names in a path string */
+    static constexpr char Separator = '.';
+
+    /** @brief Default constructor (empty path resolves to the starting node) */
+    TreePath(void) noexcept = default;
+
+    /** @brief Construct a path from hashed names */
+    TreePath(const std::initializer_list<HashedName> ids) noexcept;
+
+    /** @brief Compile a path of names separated by dots */
+    explicit TreePath(const std::string_view path) noexcept;
+
+    /** @brief Copy constructor */
+    TreePath(const TreePath &other) noexcept = default;
+
+    /** @brief Move constructor */
+    TreePath(TreePath &&other) noexcept = default;
+
+    /** @brief Destructor */
+    ~TreePath(void) noexcept = default;
+
+    /** @brief Copy assignment */
+    TreePath &operator=(const TreePath &other) noexcept = default;
+
+    /** @brief Move assignment */
+    TreePath &operator=(TreePath &&other) noexcept = default;
+
+
+    /** @brief Get the hashed names of the path */
+    [[nodiscard]] const Core::Vector<HashedName, Index> &ids(void) const noexcept { return _ids; }
+
+    /** @brief Resolve the path from 'from', returns NullIndex if not found
+     *  The result is reused as long as the same tree, starting node and tree generation are given */
+    [[nodiscard]] Index resolve(const Tree &tree, const Index from) noexcept;
+
+private:
+    Core::Vector<HashedName, Index> _ids {};
+    const Tree *_tree { nullptr };
+    std::uint64_t _generation { 0u };
+    Index _from { Tree::NullIndex };
+    Index _result { Tree::NullIndex };
+};
+
+#include "TreePath.ipp"
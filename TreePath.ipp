@@ -0,0 +1,37 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Compiled hierarchical path of a tree of objects
+ */
+
+inline kF::ObjectUtils::TreePath::TreePath(const std::initializer_list<HashedName> ids) noexcept
+{
+    _ids.reserve(static_cast<Index>(ids.size()));
+    for (const auto id : ids)
+        _ids.push(id);
+}
+
+inline kF::ObjectUtils::TreePath::TreePath(const std::string_view path) noexcept
+{
+    std::size_t begin = 0u;
+
+    if (path.empty()) [[unlikely]]
+        return;
+    while (begin <= path.size()) {
+        auto end = path.find(Separator, begin);
+        if (end == std::string_view::npos)
+            end = path.size();
+        _ids.push(Hash(path.substr(begin, end - begin)));
+        begin = end + 1u;
+    }
+}
+
+inline kF::ObjectUtils::TreePath::Index kF::ObjectUtils::TreePath::resolve(const Tree &tree, const Index from) noexcept
+{
+    if (_tree != &tree || _from != from || _generation != tree.generation()) [[unlikely]] {
+        _tree = &tree;
+        _from = from;
+        _generation = tree.generation();
+        _result = tree.findPath(from, _ids.begin(), _ids.end());
+    }
+    return _result;
+}
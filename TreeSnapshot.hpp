@@ -0,0 +1,117 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Immutable snapshots of a tree of objects
+ */
+
+#pragma once
+
+#include <atomic>
+#include <span>
+
+#include "Tree.hpp"
+
+namespace kF::ObjectUtils
+{
+    class TreeSnapshot;
+    class TreeSnapshotBuffer;
+}
+
+/** @brief An immutable copy of the hierarchy, visibility and flags of a tree
+ *
+ *  Children are flattened into a single array so that capturing a snapshot never allocates once its capacity is reached
+ *  A snapshot only refers to objects by pointer, their content must not be read from another thread
+*/
+class alignas_cacheline kF::ObjectUtils::TreeSnapshot
+{
+public:
+    /** @brief Index of a node in the snapshot (same as the captured tree) */
+    using Index = Tree::Index;
+
+    /** @brief Node flags */
+    using Flags = Tree::Flags;
+
+    /** @brief Default constructor */
+    TreeSnapshot(void) noexcept = default;
+
+    /** @brief Move constructor */
+    TreeSnapshot(TreeSnapshot &&other) noexcept = default;
+
+    /** @brief Destructor */
+    ~TreeSnapshot(void) noexcept = default;
+
+    /** @brief Move assignment */
+    TreeSnapshot &operator=(TreeSnapshot &&other) noexcept = default;
+
+
+    /** @brief Copy the current state of a tree (effective states are recomputed if needed) */
+    void capture(Tree &tree, const std::uint64_t version) noexcept;
+
+
+    /** @brief Get the version given at capture */
+    [[nodiscard]] std::uint64_t version(void) const noexcept { return _version; }
+
+    /** @brief Get the number of nodes, including the root and free slots */
+    [[nodiscard]] Index nodeCount(void) const noexcept { return _ids.size(); }
+
+
+    /** @brief Node getters */
+    [[nodiscard]] Object *object(const Index index) const noexcept { return _objects[index]; }
+    [[nodiscard]] HashedName id(const Index index) const noexcept { return _ids[index]; }
+    [[nodiscard]] Index parentIndex(const Index index) const noexcept { return _parents[index]; }
+    [[nodiscard]] bool enabled(const Index index) const noexcept { return _enabled[index]; }
+    [[nodiscard]] bool visible(const Index index) const noexcept { return _visible[index]; }
+    [[nodiscard]] bool effectivelyEnabled(const Index index) const noexcept { return _effectiveStates[index] & Tree::EffectiveEnabledBit; }
+    [[nodiscard]] bool effectivelyVisible(const Index index) const noexcept { return _effectiveStates[index] & Tree::EffectiveVisibleBit; }
+    [[nodiscard]] Flags flags(const Index index) const noexcept { return _flags[index]; }
+
+    /** @brief Get the children indexes of a node */
+    [[nodiscard]] std::span<const Index> children(const Index index) const noexcept
+        { return std::span<const Index>(_childIndexes.data() + _childOffsets[index], _childOffsets[index + 1u] - _childOffsets[index]); }
+
+private:
+    Core::Vector<Object *, Index> _objects {};
+    Core::Vector<HashedName, Index> _ids {};
+    Core::Vector<Index, Index> _parents {};
+    Core::Vector<bool, Index> _enabled {};
+    Core::Vector<bool, Index> _visible {};
+    Core::Vector<std::uint8_t, Index> _effectiveStates {};
+    Core::Vector<Flags, Index> _flags {};
+    Core::Vector<Index, Index> _childOffsets {};
+    Core::Vector<Index, Index> _childIndexes {};
+    std::uint64_t _version { 0u };
+
+    /** @brief Copy a column, reusing the snapshot capacity */
+    template<typename Type>
+    static void CopyColumn(Core::Vector<Type, Index> &to, const Core::Vector<Type, Index> &from) noexcept;
+};
+
+/** @brief A lock-free triple buffer of snapshots, with a single writer and a single reader
+ *
+ *  The writer publishes at frame boundaries while the reader always traverses the latest published snapshot
+ *  Neither side ever waits for the other and buffers are reused so steady-state publishing doesn't allocate
+*/
+class kF::ObjectUtils::TreeSnapshotBuffer
+{
+public:
+    /** @brief Capture a tree into the back buffer and publish it (writer side) */
+    void publish(Tree &tree) noexcept;
+
+    /** @brief Get the latest published snapshot (reader side), or null if nothing has been published yet
+     *  The returned snapshot remains valid and unchanged until the next call to 'acquire' */
+    [[nodiscard]] const TreeSnapshot *acquire(void) noexcept;
+
+private:
+    /** @brief Mask of the buffer index in the middle state */
+    static constexpr std::uint8_t IndexMask = 0b11;
+
+    /** @brief Bit set in the middle state when it holds a snapshot the reader didn't acquire yet */
+    static constexpr std::uint8_t FreshBit = 0b100;
+
+    TreeSnapshot _snapshots[3] {};
+    alignas_cacheline std::atomic<std::uint8_t> _middle { 1u };
+    alignas_cacheline std::uint8_t _back { 0u };
+    std::uint64_t _version { 0u };
+    alignas_cacheline std::uint8_t _front { 2u };
+};
+
+#include "TreeSnapshot.ipp"
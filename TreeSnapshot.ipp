@@ -0,0 +1,60 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Immutable snapshots of a tree of objects
+ */
+
+inline void kF::ObjectUtils::TreeSnapshot::capture(Tree &tree, const std::uint64_t version) noexcept
+{
+    const auto count = tree.nodeCount();
+
+    tree.updateEffectiveStates();
+    CopyColumn(_objects, tree._objects);
+    CopyColumn(_ids, tree._ids);
+    CopyColumn(_parents, tree._parents);
+    CopyColumn(_enabled, tree._enabled);
+    CopyColumn(_visible, tree._visible);
+    CopyColumn(_effectiveStates, tree._effectiveStates);
+    CopyColumn(_flags, tree._flags);
+    // Flatten children
+    Index childCount = 0u;
+    _childOffsets.resize(count + 1u);
+    for (Index i = 0u; i != count; ++i) {
+        _childOffsets[i] = childCount;
+        childCount += tree._children[i].size();
+    }
+    _childOffsets[count] = childCount;
+    _childIndexes.resize(childCount);
+    for (Index i = 0u; i != count; ++i) {
+        const auto &children = tree._children[i];
+        std::copy(children.begin(), children.end(), _childIndexes.begin() + _childOffsets[i]);
+    }
+    _version = version;
+}
+
+template<typename Type>
+inline void kF::ObjectUtils::TreeSnapshot::CopyColumn(Core::Vector<Type, Index> &to, const Core::Vector<Type, Index> &from) noexcept
+{
+    to.resize(from.size());
+    std::copy(from.begin(), from.end(), to.begin());
+}
+
+inline void kF::ObjectUtils::TreeSnapshotBuffer::publish(Tree &tree) noexcept
+{
+    _snapshots[_back].capture(tree, ++_version);
+    // Swap the back buffer with the middle one, marking it fresh for the reader
+    const auto previous = _middle.exchange(static_cast<std::uint8_t>(_back | FreshBit), std::memory_order_acq_rel);
+    _back = previous & IndexMask;
+}
+
+inline const kF::ObjectUtils::TreeSnapshot *kF::ObjectUtils::TreeSnapshotBuffer::acquire(void) noexcept
+{
+    // Swap the front buffer with the middle one only if the writer published since last acquire
+    if (_middle.load(std::memory_order_relaxed) & FreshBit) {
+        const auto previous = _middle.exchange(_front, std::memory_order_acq_rel);
+        _front = previous & IndexMask;
+    }
+    // Published snapshots have a non-null version, the front one is empty until the first publish
+    if (!_snapshots[_front].version()) [[unlikely]]
+        return nullptr;
+    return &_snapshots[_front];
+}
@@ -0,0 +1,61 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Weak handle over an object of a tree
+ */
+
+#pragma once
+
+#include "Tree.hpp"
+
+namespace kF
+{
+    class WeakObjectHandle;
+}
+
+/** @brief A weak reference to an object living in a tree, made of its tree, node index and node generation
+ *  It resolves in O(1) and returns null once the object left its node (removed, moved to another tree, moved by a compaction or replaced by a deserialization)
+ *  The tree must outlive the handle */
+class kF::WeakObjectHandle
+{
+public:
+    /** @brief Default constructor (null handle) */
+    WeakObjectHandle(void) noexcept = default;
+
+    /** @brief Construct a handle over a node of a tree */
+    WeakObjectHandle(const ObjectUtils::Tree &tree, const ObjectUtils::Tree::Index index) noexcept
+        : _tree(&tree), _handle(tree.handle(index)) {}
+
+    /** @brief Copy constructor */
+    WeakObjectHandle(const WeakObjectHandle &other) noexcept = default;
+
+    /** @brief Copy assignment */
+    WeakObjectHandle &operator=(const WeakObjectHandle &other) noexcept = default;
+
+
+    /** @brief Get the referenced object, null if the handle is stale */
+    [[nodiscard]] Object *get(void) const noexcept;
+
+    /** @brief Check if the handle still references its object */
+    [[nodiscard]] bool isValid(void) const noexcept { return get() != nullptr; }
+
+    /** @brief Get the tree of the handle */
+    [[nodiscard]] const ObjectUtils::Tree *tree(void) const noexcept { return _tree; }
+
+    /** @brief Get the node handle */
+    [[nodiscard]] ObjectUtils::Tree::NodeHandle nodeHandle(void) const noexcept { return _handle; }
+
+private:
+    const ObjectUtils::Tree *_tree { nullptr };
+    ObjectUtils::Tree::NodeHandle _handle {};
+};
+
+inline kF::Object *kF::WeakObjectHandle::get(void) const noexcept
+{
+    if (!_tree) [[unlikely]]
+        return nullptr;
+    const auto index = _tree->resolve(_handle);
+    if (index != ObjectUtils::Tree::NullIndex) [[likely]]
+        return _tree->get(index).object;
+    else [[unlikely]]
+        return nullptr;
+}